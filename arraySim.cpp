@@ -0,0 +1,278 @@
+/*
+file: arraySim.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    arrayDataDisks - Number of drives' worth of distinct data the array holds.
+    arrayMap - Find the drives holding a logical block and its block number on them.
+    splitWindow - Generate one window of logical requests and split it into per-drive windows.
+    arrayRun - Run one streamed experiment on a disk array with one scheduling policy.
+*/
+
+/* Array layouts (--array) */
+#define RAID_0 '0'              // Striping: each stripe unit on one drive
+#define RAID_1 '1'              // Mirroring: every block on every drive
+#define RAID_10 'x'             // Striping over mirrored pairs of drives (0,1), (2,3), ...
+
+/* Settings of a disk array run */
+struct arrayConfig
+{
+    char level;                 // RAID_0, RAID_1 or RAID_10; 0 when no array is simulated
+    int disks;                  // Drives in the array
+    int stripe;                 // Blocks per stripe unit (RAID-0 and RAID-10)
+    double writeFraction;       // Share of logical requests that are writes, sent to every copy
+};
+
+/* Statistics from one array experiment */
+struct arrayResults
+{
+    long long requests;         // Logical requests serviced
+    long long ios;              // Drive requests serviced (a mirrored write counts once per copy)
+    long long merged;           // Drive requests folded into another by the merge stage
+    double simTime;             // Simulated time until the busiest drive finished, in ms
+    double meanDriveTime;       // Mean simulated busy time of a drive in ms
+    double avgSeek;             // Mean tracks crossed per drive request
+    long long cacheHits;        // Drive requests served from the drives' caches
+    latencySummary latency;     // Time from a drive request's window being admitted to its completion
+    double wallSeconds;         // Real time the run took
+};
+
+/* One spindle of the array: its own head and statistics, advanced only by its own task */
+struct arrayDrive
+{
+    headState head;
+    latencyHist latency;
+    driveCache cache;           // The drive's own cache, when one is simulated
+    reqMerger merger;           // The drive's merge stage, when requests are merged
+    reqBatch coalesced;         // The window being serviced, after merging
+    double elapsed;             // Simulated busy time in ms
+    long long seeks;            // Tracks crossed
+    long long hits;             // Requests served from the cache
+    long long ios;              // Requests serviced
+    long long merged;           // Requests folded into another before being serviced
+};
+
+/* Windows of the stream split per epoch; the per-drive phase of an epoch runs once every window of
+   it is split, so each epoch costs two pool runs whatever the number of drives */
+#define ARRAY_EPOCH_WINDOWS 4   // Windows per epoch, per thread
+
+/*
+    int arrayDataDisks(cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Number of drives' worth of distinct data the array holds: every drive for RAID-0,
+        one for RAID-1 and half of them for RAID-10.
+    parameters:
+        cfg             I/P  arrayConfig  Array settings
+        arrayDataDisks  O/P  int          Data drives
+*/
+inline int arrayDataDisks(const arrayConfig &cfg)
+{
+    return cfg.level == RAID_0 ? cfg.disks : (cfg.level == RAID_1 ? 1 : cfg.disks / 2);
+}
+
+/*
+    void arrayMap(cfg, block, &first, &copies, &driveBlock)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Find the drives holding a logical block and its block number on them. Logical
+        blocks are cut into stripe units of cfg.stripe blocks dealt round-robin over the data
+        drives, so unit u sits on data drive u mod D at drive unit u / D. A RAID-1 block sits at the
+        same number on every drive; a RAID-10 data drive is the mirrored pair starting at drive 2d.
+    parameters:
+        cfg          I/P  arrayConfig  Array settings
+        block        I/P  uint64_t     Logical block, on a whole stripe unit of the array
+        &first       O/P  int          First drive holding the block
+        &copies      O/P  int          Number of drives holding it, first to first + copies - 1
+        &driveBlock  O/P  uint64_t     Block number on each of those drives
+*/
+inline void arrayMap(const arrayConfig &cfg, uint64_t block, int &first, int &copies, uint64_t &driveBlock)
+{
+    if (cfg.level == RAID_1)
+    {
+        first = 0;
+        copies = cfg.disks;
+        driveBlock = block;
+        return;
+    }
+    const uint64_t dataDisks = arrayDataDisks(cfg), unit = block / cfg.stripe;
+    const int member = (int)(unit % dataDisks);
+    driveBlock = unit / dataDisks * cfg.stripe + block % cfg.stripe;
+    first = cfg.level == RAID_0 ? member : 2 * member;
+    copies = cfg.level == RAID_0 ? 1 : 2;
+}
+
+/*
+    void splitWindow(cfg, key, n, first, count, &out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Generate logical requests first to first + count - 1 of the array stream and split
+        them into per-drive windows, in stream order. Request r takes the words of Philox block
+        (r mod 2^32, key.index, n, r / 2^32): the first two as a 64-bit word scaled onto the array's
+        logical blocks, the third to decide whether it is a write. A write goes to every copy of its
+        block; a read goes to the copy whose drive has the fewest requests in the window so far, and
+        between equally loaded drives to the one whose last request in the window is nearest, so
+        mirrors share reads and keep their heads apart. A window is split on its own, so windows can
+        be split in any order and on any thread.
+    parameters:
+        cfg    I/P  arrayConfig       Array settings
+        key    I/P  experimentKey     Stream the requests belong to
+        n      I/P  uint32_t          Low 32 bits of the stream's request count
+        first  I/P  long long         Index of the first logical request of the window
+        count  I/P  int               Number of logical requests in the window
+        &out   O/P  vector<reqBatch>  Per-drive windows, cfg.disks of them; overwritten
+*/
+void splitWindow(const arrayConfig &cfg, experimentKey key, uint32_t n, long long first, int count,
+                 vector<reqBatch> &out)
+{
+    PROFILE_PHASE(PHASE_GENERATE);
+    thread_local vector<uint32_t> words[4];
+    for (vector<uint32_t> &w : words)
+        if ((int)w.size() < count)
+            w.resize(count);
+    for (long long b = first; b < first + count;)
+    {
+        long long end = std::min(first + count, (long long)(((uint64_t)b | 0xffffffffu) + 1));
+        size_t at = b - first;
+        philoxBlocks(key.seed, key.stream, (uint32_t)b, key.index, n, (uint32_t)((uint64_t)b >> 32), (int)(end - b),
+                     words[0].data() + at, words[1].data() + at, words[2].data() + at, words[3].data() + at);
+        b = end;
+    }
+
+    for (reqBatch &d : out)
+        d.clear();
+    // a striped drive only holds whole stripe units, so a partial one at its end is left unused
+    const uint64_t logicalBlocks = cfg.level == RAID_1 ? drive.blocks
+                                                      : drive.blocks / cfg.stripe * cfg.stripe * arrayDataDisks(cfg);
+    const uint64_t writeBelow = (uint64_t)(cfg.writeFraction * 4294967296.0);
+    for (int k = 0; k < count; k++)
+    {
+        uint64_t x = (uint64_t)words[0][k] << 32 | words[1][k];
+        uint64_t block = (uint64_t)((unsigned __int128)x * logicalBlocks >> 64), driveBlock;
+        int firstDrive, copies, track, sector;
+        arrayMap(cfg, block, firstDrive, copies, driveBlock);
+        placeBlock(driveBlock, track, sector);
+
+        if (words[2][k] < writeBelow)
+        {
+            for (int c = 0; c < copies; c++)
+                out[firstDrive + c].push_back(track, sector);
+            continue;
+        }
+        int best = firstDrive;
+        for (int d = firstDrive + 1; d < firstDrive + copies; d++)
+        {
+            const reqBatch &cand = out[d], &cur = out[best];
+            if (cand.size() < cur.size() ||
+                (cand.size() == cur.size() && cand.size() > 0 &&
+                 abs(cand.track.back() - track) < abs(cur.track.back() - track)))
+                best = d;
+        }
+        out[best].push_back(track, sector);
+    }
+}
+
+/*
+    arrayResults arrayRun<Policy>(cfg, stream, pool)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run one streamed experiment of stream.requests logical requests on a disk array
+        with one scheduling policy on every drive. The stream is admitted stream.window logical
+        requests at a time; each window is split over the drives (splitWindow) and every drive
+        services its share with Policy::serviceWindow from where its head was left, through its own
+        cache if one is simulated and after its own merge stage with --coalesce, independently of
+        the other drives. The run alternates between splitting an epoch of windows, one window per
+        task, and servicing them, one drive per task, so the drives run in parallel and the results
+        do not depend on the number of threads. The array is done when its busiest drive is, so
+        throughput is requests / simTime.
+    parameters:
+        Policy    I/P  class         Scheduling policy (see schedPolicy.cpp)
+        cfg       I/P  arrayConfig   Array settings
+        stream    I/P  streamConfig  Request count, window size and seed of the logical stream
+        pool      I/P  threadPool    Threads the windows and drives are run on
+        arrayRun  O/P  arrayResults  Statistics of the whole array
+*/
+template <class Policy>
+arrayResults arrayRun(const arrayConfig &cfg, const streamConfig &stream, threadPool &pool)
+{
+    std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+
+    const experimentKey key{stream.seed, STREAM_ARRAY, 0};
+    const int epochWindows = ARRAY_EPOCH_WINDOWS * pool.size();
+    vector<vector<reqBatch>> split(epochWindows, vector<reqBatch>(cfg.disks));
+    vector<arrayDrive> drives(cfg.disks);
+    for (arrayDrive &d : drives)
+    {
+        d.head = startHead();
+        d.elapsed = 0;
+        d.seeks = 0;
+        d.hits = 0;
+        d.ios = 0;
+        d.merged = 0;
+        if (cacheSettings.segments > 0)
+            d.cache.clear();
+    }
+
+    for (long long done = 0; done < stream.requests;)
+    {
+        const long long left = stream.requests - done;
+        const int windows = (int)min((long long)epochWindows, (left + stream.window - 1) / stream.window);
+        pool.run(windows, [&](int w, int) {
+            long long first = done + (long long)w * stream.window;
+            splitWindow(cfg, key, (uint32_t)stream.requests, first,
+                        (int)min((long long)stream.window, stream.requests - first), split[w]);
+        });
+        pool.run(cfg.disks, [&](int d, int) {
+            arrayDrive &spindle = drives[d];
+            latencySink = &spindle.latency;
+            activeCache = cacheSettings.segments > 0 ? &spindle.cache : nullptr;
+            activeMerger = mergeSettings.maxBlocks > 0 ? &spindle.merger : nullptr;
+            for (int w = 0; w < windows; w++)
+            {
+                reqSpan window = split[w][d].span();
+                if (window.size == 0)
+                    continue;
+                if (activeMerger)
+                {
+                    spindle.merger.merge(window, spindle.coalesced);
+                    window = spindle.coalesced.span();
+                    spindle.merged += spindle.merger.absorbed();
+                }
+                streamWindow<Policy>(spindle.head, window, spindle.elapsed, spindle.seeks, spindle.hits);
+                spindle.ios += window.size;
+            }
+            latencySink = nullptr;
+            latencyOrigin = 0;
+            activeCache = nullptr;
+            activeMerger = nullptr;
+        });
+        done += min(left, (long long)windows * stream.window);
+    }
+
+    // drives are merged in index order, so the histogram is the same for any thread count
+    arrayResults res;
+    latencyHist latency;
+    long long seeks = 0;
+    res.requests = stream.requests;
+    res.ios = 0;
+    res.cacheHits = 0;
+    res.merged = 0;
+    res.simTime = 0;
+    res.meanDriveTime = 0;
+    for (const arrayDrive &d : drives)
+    {
+        latency.merge(d.latency);
+        seeks += d.seeks;
+        res.ios += d.ios;
+        res.cacheHits += d.hits;
+        res.merged += d.merged;
+        res.simTime = max(res.simTime, d.elapsed);
+        res.meanDriveTime += d.elapsed / cfg.disks;
+    }
+    res.avgSeek = res.ios > 0 ? (double)seeks / res.ios : 0;
+    res.latency = latency.summary();
+    res.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return res;
+}
@@ -0,0 +1,280 @@
+/*
+file: counterRng.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    philoxMulHiLo - Full 64-bit product of two 32-bit values, split into halves.
+    philox4x32 - Philox4x32-10: four random words for one counter under one key.
+    philoxBlocks - Philox blocks for a run of consecutive counters, several at a time.
+    philoxEngine - Constructor method that starts a sequential stream of one key's words.
+    philoxEngine::operator() - Next 32-bit word of the stream.
+    philoxEngine::discard - Skip words of the stream in constant time.
+*/
+
+#include <cstdint>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* Counter-based generation (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"): every
+   block of four random words is a keyed bijection of a 128-bit counter, so the words of any counter
+   can be computed on their own without running through the ones before it. The key is the run's
+   seed and a stream; the counter names what the words are for. Requests of an experiment use
+   counter (block, experiment index, request count, 0), two requests per block (drawRequests), so
+   any thread, process or shard generates any experiment, or any request of it, in O(1). */
+#define PHILOX_M0 0xD2511F53u   // Round multipliers
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u   // Key schedule increments (golden ratio, sqrt(3) - 1)
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+/* Key streams other than an algorithm's sweep, which uses the policy's id character */
+#define STREAM_SHARED 0x100     // Fused mode: one request set per experiment for every algorithm
+#define STREAM_ARRIVALS 0x101   // Event simulation: the arrival stream every algorithm sees
+#define STREAM_WINDOWS 0x102    // Streaming mode: the request stream every algorithm sees
+#define STREAM_ARRAY 0x103      // Array mode: the logical request stream every algorithm sees
+#define STREAM_ONLINE 0x104     // Online stress: the requests the producers submit
+
+/* Names one experiment's request set: with its request count, the key and counter of the blocks
+   its requests are drawn from */
+struct experimentKey
+{
+    uint32_t seed;              // Seed of the run (--seed)
+    uint32_t stream;            // Independent stream: the algorithm in the sweep, or a STREAM_ value
+    uint32_t index;             // Experiment index within its test
+};
+
+/*
+    uint32_t philoxMulHiLo(a, b, &hi)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Full 64-bit product of two 32-bit values, split into halves.
+    parameters:
+        a              I/P  uint32_t  Multiplicand
+        b              I/P  uint32_t  Multiplier
+        &hi            O/P  uint32_t  High 32 bits of the product
+        philoxMulHiLo  O/P  uint32_t  Low 32 bits of the product
+*/
+inline uint32_t philoxMulHiLo(uint32_t a, uint32_t b, uint32_t &hi)
+{
+    uint64_t p = (uint64_t)a * b;
+    hi = (uint32_t)(p >> 32);
+    return (uint32_t)p;
+}
+
+/*
+    void philox4x32(ctr, k0, k1, out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Philox4x32-10: four random words for one counter under one key. Matches the known
+        answers of the Random123 reference (counter 0 under key 0 gives 6627e8d5 e169c58d bc57ac4c
+        9b00dbd8).
+    parameters:
+        ctr  I/P  uint32_t*  Counter, four words
+        k0   I/P  uint32_t   First key word
+        k1   I/P  uint32_t   Second key word
+        out  O/P  uint32_t*  Random words, four
+*/
+inline void philox4x32(const uint32_t *ctr, uint32_t k0, uint32_t k1, uint32_t *out)
+{
+    uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    for (int r = 0; r < PHILOX_ROUNDS; r++)
+    {
+        uint32_t hi0, hi1;
+        uint32_t lo0 = philoxMulHiLo(PHILOX_M0, c0, hi0);
+        uint32_t lo1 = philoxMulHiLo(PHILOX_M1, c2, hi1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/*
+    void philoxBlocks(k0, k1, first, c1, c2, c3, count, w0, w1, w2, w3)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Philox blocks for the counters (first + j, c1, c2, c3), j below count, one word of
+        every block per output array. With AVX-512 or AVX2 the rounds run on 16 or 8 counters at a
+        time, with the 32 by 32 bit products taken as even and odd 64-bit lanes; the remainder, or
+        everything in a build without them, goes through philox4x32. Either way the words are
+        exactly philox4x32's.
+    parameters:
+        k0     I/P  uint32_t   First key word
+        k1     I/P  uint32_t   Second key word
+        first  I/P  uint32_t   First word of the first counter
+        c1     I/P  uint32_t   Second word of every counter
+        c2     I/P  uint32_t   Third word of every counter
+        c3     I/P  uint32_t   Fourth word of every counter
+        count  I/P  int        Number of blocks
+        w0     O/P  uint32_t*  First word of each block, count entries
+        w1     O/P  uint32_t*  Second word of each block
+        w2     O/P  uint32_t*  Third word of each block
+        w3     O/P  uint32_t*  Fourth word of each block
+*/
+void philoxBlocks(uint32_t k0, uint32_t k1, uint32_t first, uint32_t c1, uint32_t c2, uint32_t c3, int count,
+                  uint32_t *w0, uint32_t *w1, uint32_t *w2, uint32_t *w3)
+{
+    int j = 0;
+#if defined(__AVX512F__)
+    const __m512i m0 = _mm512_set1_epi32((int)PHILOX_M0), m1 = _mm512_set1_epi32((int)PHILOX_M1);
+    const __m512i step = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    for (; j + 16 <= count; j += 16)
+    {
+        __m512i x0 = _mm512_add_epi32(_mm512_set1_epi32((int)(first + j)), step);
+        __m512i x1 = _mm512_set1_epi32((int)c1), x2 = _mm512_set1_epi32((int)c2), x3 = _mm512_set1_epi32((int)c3);
+        uint32_t key0 = k0, key1 = k1;
+        for (int r = 0; r < PHILOX_ROUNDS; r++)
+        {
+            // even lanes multiply in place, odd lanes after shifting down into the even slots
+            __m512i e0 = _mm512_mul_epu32(x0, m0), o0 = _mm512_mul_epu32(_mm512_srli_epi64(x0, 32), m0);
+            __m512i e1 = _mm512_mul_epu32(x2, m1), o1 = _mm512_mul_epu32(_mm512_srli_epi64(x2, 32), m1);
+            __m512i lo0 = _mm512_mask_blend_epi32(0xAAAA, e0, _mm512_slli_epi64(o0, 32));
+            __m512i hi0 = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(e0, 32), o0);
+            __m512i lo1 = _mm512_mask_blend_epi32(0xAAAA, e1, _mm512_slli_epi64(o1, 32));
+            __m512i hi1 = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(e1, 32), o1);
+            x0 = _mm512_xor_si512(_mm512_xor_si512(hi1, x1), _mm512_set1_epi32((int)key0));
+            x1 = lo1;
+            x2 = _mm512_xor_si512(_mm512_xor_si512(hi0, x3), _mm512_set1_epi32((int)key1));
+            x3 = lo0;
+            key0 += PHILOX_W0;
+            key1 += PHILOX_W1;
+        }
+        _mm512_storeu_si512(w0 + j, x0);
+        _mm512_storeu_si512(w1 + j, x1);
+        _mm512_storeu_si512(w2 + j, x2);
+        _mm512_storeu_si512(w3 + j, x3);
+    }
+#elif defined(__AVX2__)
+    const __m256i m0 = _mm256_set1_epi32((int)PHILOX_M0), m1 = _mm256_set1_epi32((int)PHILOX_M1);
+    const __m256i step = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    for (; j + 8 <= count; j += 8)
+    {
+        __m256i x0 = _mm256_add_epi32(_mm256_set1_epi32((int)(first + j)), step);
+        __m256i x1 = _mm256_set1_epi32((int)c1), x2 = _mm256_set1_epi32((int)c2), x3 = _mm256_set1_epi32((int)c3);
+        uint32_t key0 = k0, key1 = k1;
+        for (int r = 0; r < PHILOX_ROUNDS; r++)
+        {
+            __m256i e0 = _mm256_mul_epu32(x0, m0), o0 = _mm256_mul_epu32(_mm256_srli_epi64(x0, 32), m0);
+            __m256i e1 = _mm256_mul_epu32(x2, m1), o1 = _mm256_mul_epu32(_mm256_srli_epi64(x2, 32), m1);
+            __m256i lo0 = _mm256_blend_epi32(e0, _mm256_slli_epi64(o0, 32), 0xAA);
+            __m256i hi0 = _mm256_blend_epi32(_mm256_srli_epi64(e0, 32), o0, 0xAA);
+            __m256i lo1 = _mm256_blend_epi32(e1, _mm256_slli_epi64(o1, 32), 0xAA);
+            __m256i hi1 = _mm256_blend_epi32(_mm256_srli_epi64(e1, 32), o1, 0xAA);
+            x0 = _mm256_xor_si256(_mm256_xor_si256(hi1, x1), _mm256_set1_epi32((int)key0));
+            x1 = lo1;
+            x2 = _mm256_xor_si256(_mm256_xor_si256(hi0, x3), _mm256_set1_epi32((int)key1));
+            x3 = lo0;
+            key0 += PHILOX_W0;
+            key1 += PHILOX_W1;
+        }
+        _mm256_storeu_si256((__m256i *)(w0 + j), x0);
+        _mm256_storeu_si256((__m256i *)(w1 + j), x1);
+        _mm256_storeu_si256((__m256i *)(w2 + j), x2);
+        _mm256_storeu_si256((__m256i *)(w3 + j), x3);
+    }
+#endif
+    for (; j < count; j++)
+    {
+        uint32_t ctr[4] = {first + (uint32_t)j, c1, c2, c3}, out[4];
+        philox4x32(ctr, k0, k1, out);
+        w0[j] = out[0];
+        w1[j] = out[1];
+        w2[j] = out[2];
+        w3[j] = out[3];
+    }
+}
+
+/* Sequential words of one key, for the consumers that draw as they go (arrival gaps, streamed
+   requests): counter (position / 4, c1, c2, c3). A UniformRandomBitGenerator, so the standard
+   distributions take it, and discard jumps without generating. */
+class philoxEngine
+{
+public:
+    typedef uint32_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xffffffffu; }
+
+    philoxEngine(uint32_t k0, uint32_t k1, uint32_t c1 = 0, uint32_t c2 = 0, uint32_t c3 = 0);
+    result_type operator()();
+    void discard(uint64_t words);
+
+private:
+    uint32_t key[2];
+    uint32_t ctr[4];            // Counter of the buffered block; ctr[0] is its index in the stream
+    uint32_t block[4];          // Words of the current block
+    int used;                   // Words of the block handed out; 4 when it must be (re)generated
+};
+
+/*
+    philoxEngine(k0, k1, c1, c2, c3)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that starts a sequential stream of one key's words, at the
+        first word of block (0, c1, c2, c3).
+    parameters:
+        k0  I/P  uint32_t  First key word
+        k1  I/P  uint32_t  Second key word
+        c1  I/P  uint32_t  Second counter word of every block of the stream
+        c2  I/P  uint32_t  Third counter word
+        c3  I/P  uint32_t  Fourth counter word
+*/
+philoxEngine::philoxEngine(uint32_t k0, uint32_t k1, uint32_t c1, uint32_t c2, uint32_t c3)
+{
+    key[0] = k0;
+    key[1] = k1;
+    ctr[0] = 0;
+    ctr[1] = c1;
+    ctr[2] = c2;
+    ctr[3] = c3;
+    used = 4;
+}
+
+/*
+    uint32_t operator()()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Next 32-bit word of the stream.
+    parameters:
+        operator()  O/P  uint32_t  Uniform random word
+*/
+inline philoxEngine::result_type philoxEngine::operator()()
+{
+    if (used == 4)
+    {
+        philox4x32(ctr, key[0], key[1], block);
+        ctr[0]++;
+        used = 0;
+    }
+    return block[used++];
+}
+
+/*
+    void discard(words)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Skip words of the stream in constant time: only the block the stream lands in is
+        generated.
+    parameters:
+        words  I/P  uint64_t  Number of words to skip
+*/
+void philoxEngine::discard(uint64_t words)
+{
+    uint64_t position = (uint64_t)ctr[0] * 4 - (4 - used) + words;
+    ctr[0] = (uint32_t)(position / 4);
+    used = 4;
+    if (position % 4 != 0)
+    {
+        philox4x32(ctr, key[0], key[1], block);
+        ctr[0]++;
+        used = (int)(position % 4);
+    }
+}
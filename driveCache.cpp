@@ -0,0 +1,209 @@
+/*
+file: driveCache.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    driveCache::clear - Drop every cached segment, as at power-on.
+    driveCache::access - Look a request up, caching it and its track's read-ahead on a miss.
+    driveCache::touch - Move a used segment to the most recently used end of the protected list.
+    driveCache::unlink - Take a segment out of its list.
+    driveCache::link - Put a segment on a list just before another.
+*/
+
+/* Settings of the drive's cache (--cache); segments is 0 when requests always go to the platter */
+struct cacheConfig
+{
+    int segments;               // Segments in the cache, each one track's read-ahead
+};
+
+cacheConfig cacheSettings = {0};
+
+/* A segmented LRU (SLRU) of track buffers. A miss reads the requested sector and carries on to the
+   end of the track, and the segment keeps sectors [start, end of track) of that track; a request on
+   a cached range is served from the buffer without seeking or waiting for the platter. New segments
+   go on the probationary list and move to the protected list the first time they are used again,
+   so a long run of one-off tracks only flushes probationary ones. Each list is least recently used
+   first out. The protected list is circular around a sentinel; probation is never empty, as the
+   protected list holds at most half the segments, so it is a plain ring read from its head, and a
+   miss reuses its least recently used segment by moving the head back one. A track has at most
+   one segment, found through a per-track slot index, so a lookup, with its fill and eviction on a
+   miss, is O(1); clear only visits the segments. */
+#define CACHE_PROTECTED_PERCENT 50      // Share of the segments the protected list may hold
+
+class driveCache
+{
+public:
+    driveCache() : probationHead(0), protectedSize(0), protectedCapacity(0) {}
+    void clear();
+    inline bool access(int track, int sector);
+
+private:
+    struct segment
+    {
+        int track;              // Track buffered; drive.tracks for an empty segment
+        int start;              // First buffered sector; the segment runs to the end of the track
+        int prev, next;         // Neighbours in its circular list
+        bool isProtected;       // On the protected list rather than probation
+    };
+
+    int protectedList() const { return (int)seg.size() - 1; }
+    inline void touch(int s);
+    inline void unlink(int s);
+    inline void link(int s, int next);
+
+    vector<segment> seg;        // The segments, then the protected list's sentinel
+    vector<int> slotOf;         // Segment holding each track, -1 for none; one extra for empty segments
+    int probationHead;          // Most recently used probationary segment
+    int protectedSize;          // Segments on the protected list
+    int protectedCapacity;      // Most segments the protected list may hold
+};
+
+/* Cache the current thread services requests through (see serviceSequence); null when requests
+   always go to the platter. Drivers clear it wherever a fresh drive starts. */
+thread_local driveCache *activeCache = nullptr;
+
+/*
+    void clear()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Drop every cached segment, as at power-on, sizing the cache from cacheSettings and
+        the index from the simulated drive on first use. The empty segments all go on probation,
+        so a miss always has a probationary segment to take. Needs at least one segment.
+*/
+void driveCache::clear()
+{
+    const int segments = cacheSettings.segments;
+    if ((int)seg.size() != segments + 1 || (int)slotOf.size() != drive.tracks + 1)
+    {
+        seg.assign(segments + 1, segment{drive.tracks, 0, 0, 0, false});
+        slotOf.assign(drive.tracks + 1, -1);
+        protectedCapacity = segments * CACHE_PROTECTED_PERCENT / 100;
+    }
+    for (int s = 0; s < segments; s++)
+        slotOf[seg[s].track] = -1;
+
+    for (int s = 0; s < segments; s++)
+        seg[s] = segment{drive.tracks, 0, (s + segments - 1) % segments, (s + 1) % segments, false};
+    seg[protectedList()].prev = seg[protectedList()].next = protectedList();
+    probationHead = 0;
+    protectedSize = 0;
+}
+
+/*
+    bool access(track, sector)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Look a request up in the cache. On a hit its segment is marked used (see touch).
+        On a miss the request is read from the platter, with the read-ahead to the end of its
+        track: a track already buffered from a later sector has its segment extended back and
+        marked used; otherwise the least recently used probationary segment is taken for it and
+        becomes the head of probation.
+    parameters:
+        track   I/P  int   Track of the request
+        sector  I/P  int   Sector of the request
+        access  O/P  bool  True if the request is served from the buffer
+*/
+inline bool driveCache::access(int track, int sector)
+{
+    int s = slotOf[track];
+    if (s >= 0)
+    {
+        const bool hit = sector >= seg[s].start;
+        seg[s].start = min(seg[s].start, sector);
+        touch(s);
+        return hit;
+    }
+
+    // the ring's tail is just before its head, so taking it is only a move of the head
+    s = seg[probationHead].prev;
+    slotOf[seg[s].track] = -1;
+    slotOf[track] = s;
+    seg[s].track = track;
+    seg[s].start = sector;
+    probationHead = s;
+    return false;
+}
+
+/*
+    void touch(s)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Move a used segment to the most recently used end of the protected list, demoting
+        the least recently used protected segment to the head of probation if that list is full.
+        With no room for a protected list the segment becomes the head of probation instead. A run
+        of requests on one track touches the same segment again and again, so that case returns
+        straight away.
+    parameters:
+        s  I/P  int  Segment used
+*/
+inline void driveCache::touch(int s)
+{
+    if (seg[s].isProtected)
+    {
+        if (s == seg[protectedList()].next)
+            return;
+        unlink(s);
+        link(s, seg[protectedList()].next);
+        return;
+    }
+    if (protectedCapacity == 0)
+    {
+        if (s == probationHead)
+            return;
+        unlink(s);
+        link(s, probationHead);
+        probationHead = s;
+        return;
+    }
+    if (protectedSize == protectedCapacity)
+    {
+        // the demoted segment joins probation first, so probation never runs empty
+        int demoted = seg[protectedList()].prev;
+        unlink(demoted);
+        link(demoted, probationHead);
+        seg[demoted].isProtected = false;
+        probationHead = demoted;
+    }
+    else
+        protectedSize++;
+    if (s == probationHead)
+        probationHead = seg[s].next;
+    unlink(s);
+    link(s, seg[protectedList()].next);
+    seg[s].isProtected = true;
+}
+
+/*
+    void unlink(s)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Take a segment out of its list.
+    parameters:
+        s  I/P  int  Segment on a list
+*/
+inline void driveCache::unlink(int s)
+{
+    seg[seg[s].prev].next = seg[s].next;
+    seg[seg[s].next].prev = seg[s].prev;
+}
+
+/*
+    void link(s, next)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Put a segment on a list just before another, so before probation's head or after
+        the protected sentinel it becomes the list's most recently used segment.
+    parameters:
+        s     I/P  int  Segment on no list
+        next  I/P  int  Segment or sentinel it goes before
+*/
+inline void driveCache::link(int s, int next)
+{
+    const int prev = seg[next].prev;
+    seg[s].prev = prev;
+    seg[s].next = next;
+    seg[prev].next = s;
+    seg[next].prev = s;
+}
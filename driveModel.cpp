@@ -0,0 +1,345 @@
+/*
+file: driveModel.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    seekCurve::time - Seek time for a track distance.
+    buildDriveTables - Fill a drive model's lookup tables from its description.
+    builtinDrive - The drive described by the constants in hddSim.cpp.
+    loadDriveModel - Read a drive description from a config file.
+    placeBlock - Find the track and sector of a block number.
+    placeRequest - Place a request on the drive from two uniform random words.
+    drawRequest - Draw one uniformly placed request on the drive.
+    drawRequests - Draw a run of an experiment's requests straight from their counters.
+*/
+
+#include <cstdint>
+#include <sstream>
+
+/* Time needed to transfer one block in milliseconds */
+const float TRANSFER_MS = (float)(BLOCK_SIZE * 1024) / (float)6000000000 * 1000;
+
+/* Seek time as a function of distance: settle + sqrtMs * sqrt(d) up to knee tracks (the arm is
+   still accelerating), then linear at linearMs per track (coasting). A zero distance costs nothing. */
+struct seekCurve
+{
+    double settle;              // Fixed cost of any non-zero seek in ms
+    double sqrtMs;              // ms per square root of a track, below the knee
+    double linearMs;            // ms per track, from the knee on
+    int knee;                   // Distance in tracks where the curve turns linear
+
+    double time(int d) const;
+};
+
+/* A run of tracks recorded with the same number of sectors */
+struct driveZone
+{
+    int firstTrack;             // First track of the zone
+    int sectors;                // Sectors per track
+    float sectorRate;           // Sectors passing under the head per ms of clock (see updateSector)
+    float msPerSector;          // Rotational latency per sector waited
+    int rotBase;                // Offset of the zone's rotation table in driveModel::rotTable
+    uint64_t firstBlock;        // Block number of the zone's first sector
+};
+
+/* Description of the simulated drive plus the lookup tables the service kernel reads. Every zone
+   turns at the same rate, so the head's angle is common to all tracks and a zone only changes how
+   many sectors that angle is divided into. */
+struct driveModel
+{
+    int tracks;                 // Number of tracks
+    int rpm;                    // Rotations per minute
+    seekCurve seek;             // Seek time curve
+    std::vector<driveZone> zones;       // Zones in track order, the first starting at track 0
+
+    // derived by buildDriveTables
+    int maxSectors;             // Sectors on the largest track
+    uint64_t blocks;            // Blocks on the whole drive
+    float rotFactor;            // Rotation model factor at 360 sectors (ROT_FACTOR for the built-in drive)
+    double rotationPeriod;      // Clock period after which every zone's updateSector repeats
+    float accessTime;           // Nominal access time reported with the results
+    bool isDefault;             // Matches defaultGeometry, so the constant-folded kernel is used
+    std::vector<float> seekTable;       // Seek time in ms by track distance
+    std::vector<uint8_t> trackZone;     // Zone index by track
+    std::vector<float> rotTable;        // Rotational latency in ms by zone (rotBase) and sectors waited
+
+    int zoneOf(int track) const { return trackZone[track]; }
+    int sectorsOn(int track) const { return zones[trackZone[track]].sectors; }
+};
+
+/*
+    double time(d)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Seek time for a track distance.
+    parameters:
+        d     I/P  int     Tracks crossed
+        time  O/P  double  Seek time in milliseconds
+*/
+double seekCurve::time(int d) const
+{
+    if (d == 0)
+        return 0;
+    if (d < knee)
+        return settle + sqrtMs * sqrt((double)d);
+    return settle + sqrtMs * sqrt((double)knee) + linearMs * (d - knee);
+}
+
+/*
+    void buildDriveTables(&model)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Fill a drive model's lookup tables from its description: seek time for every
+        distance, the zone of every track, and one rotational latency table per zone. A zone with
+        S sectors keeps the built-in rotation model with every sector standing for 360 / S of the
+        built-in drive's sectors, so a uniform 360-sector zone reproduces it exactly.
+    parameters:
+        &model  I/P  driveModel  Drive description; its derived fields are filled in
+*/
+void buildDriveTables(driveModel &model)
+{
+    const double rotFactor = model.rpm / 60000.0 / 360; // RPMS / 360 for the built-in drive
+    model.rotFactor = (float)rotFactor;
+    model.rotationPeriod = 360 / model.rotFactor;
+
+    model.seekTable.resize(model.tracks);
+    for (int d = 0; d < model.tracks; d++)
+        model.seekTable[d] = (float)model.seek.time(d);
+
+    model.maxSectors = 0;
+    model.blocks = 0;
+    model.trackZone.resize(model.tracks);
+    for (size_t z = 0; z < model.zones.size(); z++)
+    {
+        driveZone &zone = model.zones[z];
+        int end = z + 1 < model.zones.size() ? model.zones[z + 1].firstTrack : model.tracks;
+        std::fill(model.trackZone.begin() + zone.firstTrack, model.trackZone.begin() + end, (uint8_t)z);
+        zone.firstBlock = model.blocks;
+        model.blocks += (uint64_t)(end - zone.firstTrack) * zone.sectors;
+        zone.sectorRate = (float)(rotFactor * (zone.sectors / 360.0));
+        zone.msPerSector = (float)(rotFactor * (360.0 / zone.sectors));
+        model.maxSectors = max(model.maxSectors, zone.sectors);
+    }
+
+    model.rotTable.clear();
+    for (driveZone &zone : model.zones)
+    {
+        zone.rotBase = (int)model.rotTable.size();
+        for (int s = 0; s <= zone.sectors; s++)
+            model.rotTable.push_back((float)s * zone.msPerSector);
+    }
+
+    model.isDefault = model.tracks == TRACKS && model.rpm == RPM && model.zones.size() == 1 &&
+                      model.zones[0].sectors == SECTORS && model.seek.settle == 0 && model.seek.sqrtMs == 0 &&
+                      model.seek.knee == 0 && model.seek.linearMs == AVG_SEEK_TIME;
+
+    // the assignment's figure for the built-in drive; otherwise a seek across a third of the disk
+    // (the mean distance between two uniform tracks), half a rotation of the first zone and a transfer
+    if (model.isDefault)
+        model.accessTime = AVG_SEEK_TIME + (1 / (2 * RPM)) + TRANSFER_MS;
+    else
+        model.accessTime = model.seekTable[model.tracks / 3] + model.rotTable[model.zones[0].sectors / 2] + TRANSFER_MS;
+}
+
+/*
+    driveModel builtinDrive()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: The drive described by the constants in hddSim.cpp: TRACKS tracks of SECTORS
+        sectors at RPM, with a seek time linear in distance.
+    parameters:
+        builtinDrive  O/P  driveModel  Drive model with its tables built
+*/
+driveModel builtinDrive()
+{
+    driveModel model;
+    model.tracks = TRACKS;
+    model.rpm = RPM;
+    model.seek = seekCurve{0, 0, AVG_SEEK_TIME, 0};
+    model.zones.push_back(driveZone{0, SECTORS, 0, 0, 0, 0});
+    buildDriveTables(model);
+    return model;
+}
+
+/* The drive being simulated; the built-in one unless --drive loads another before any run */
+driveModel drive = builtinDrive();
+
+/*
+    bool loadDriveModel(path, &model)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Read a drive description from a config file. One setting per line, '#' starts a
+        comment:
+            tracks N                                number of tracks
+            rpm N                                   rotations per minute
+            seek SETTLE SQRT_MS LINEAR_MS KNEE      seek curve (see seekCurve)
+            zone FIRST_TRACK SECTORS                one per zone, in track order, the first at 0
+        Settings that are left out keep the built-in drive's values. Problems are reported on
+        stderr with the line they were found on.
+    parameters:
+        path            I/P  char*       Config file
+        &model          O/P  driveModel  Drive model with its tables built
+        loadDriveModel  O/P  bool        False if the file could not be read or is not valid
+*/
+bool loadDriveModel(const char *path, driveModel &model)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        cerr << "cannot read drive config: " << path << "\n";
+        return false;
+    }
+
+    model = builtinDrive();
+    model.zones.clear();
+    std::string line;
+    for (int lineNo = 1; getline(file, line); lineNo++)
+    {
+        std::istringstream in(line.substr(0, line.find('#')));
+        std::string key;
+        if (!(in >> key))
+            continue;
+
+        bool ok;
+        if (key == "tracks")
+            ok = (bool)(in >> model.tracks) && model.tracks > 0 && model.tracks <= (1 << 24);
+        else if (key == "rpm")
+            ok = (bool)(in >> model.rpm) && model.rpm > 0;
+        else if (key == "seek")
+            ok = (bool)(in >> model.seek.settle >> model.seek.sqrtMs >> model.seek.linearMs >> model.seek.knee) &&
+                 model.seek.settle >= 0 && model.seek.sqrtMs >= 0 && model.seek.linearMs >= 0 && model.seek.knee >= 0;
+        else if (key == "zone")
+        {
+            driveZone z = {0, 0, 0, 0, 0, 0};
+            ok = (bool)(in >> z.firstTrack >> z.sectors) && z.sectors > 0 && z.sectors <= 65536 &&
+                 model.zones.size() < 256 &&
+                 (model.zones.empty() ? z.firstTrack == 0 : z.firstTrack > model.zones.back().firstTrack);
+            model.zones.push_back(z);
+        }
+        else
+            ok = false;
+
+        std::string extra;
+        if (!ok || in >> extra)
+        {
+            cerr << path << ":" << lineNo << ": cannot use '" << line << "'\n";
+            return false;
+        }
+    }
+
+    if (model.zones.empty())
+        model.zones.push_back(driveZone{0, SECTORS, 0, 0, 0, 0});
+    if (model.zones.back().firstTrack >= model.tracks)
+    {
+        cerr << path << ": zone starts past the last track\n";
+        return false;
+    }
+    buildDriveTables(model);
+    return true;
+}
+
+/*
+    void placeBlock(block, &track, &sector)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Find the track and sector of a block number. Blocks are numbered zone by zone and
+        track by track, drive.blocks of them in all.
+    parameters:
+        block    I/P  uint64_t  Block number, below drive.blocks
+        &track   O/P  int       Track holding the block
+        &sector  O/P  int       Sector of the block on its track
+*/
+inline void placeBlock(uint64_t block, int &track, int &sector)
+{
+    // zones are few, so finding the one holding the block is a short search
+    size_t z = drive.zones.size() - 1;
+    while (drive.zones[z].firstBlock > block)
+        z--;
+    const driveZone &zone = drive.zones[z];
+    track = zone.firstTrack + (int)((block - zone.firstBlock) / zone.sectors);
+    sector = (int)((block - zone.firstBlock) % zone.sectors);
+}
+
+/*
+    void placeRequest(x0, x1, &track, &sector)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Place a request on the drive from two uniform random words: a uniform track from
+        the first, then a uniform sector of that track from the second. The words are scaled by a
+        multiply and shift, so every track and sector is equally likely to within 2^-32.
+    parameters:
+        x0       I/P  uint32_t  Random word for the track
+        x1       I/P  uint32_t  Random word for the sector
+        &track   O/P  int       Track of the request
+        &sector  O/P  int       Sector of the request
+*/
+inline void placeRequest(uint32_t x0, uint32_t x1, int &track, int &sector)
+{
+    track = (int)(((uint64_t)x0 * (uint64_t)drive.tracks) >> 32);
+    sector = (int)(((uint64_t)x1 * (uint64_t)drive.sectorsOn(track)) >> 32);
+}
+
+/*
+    void drawRequest(&gen, &track, &sector)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Draw one uniformly placed request on the drive from the next two words of a
+        sequential generator (see placeRequest).
+    parameters:
+        &gen     I/P  philoxEngine  Random word stream
+        &track   O/P  int           Track of the request
+        &sector  O/P  int           Sector of the request
+*/
+inline void drawRequest(philoxEngine &gen, int &track, int &sector)
+{
+    uint32_t x0 = gen();
+    placeRequest(x0, gen(), track, sector);
+}
+
+/*
+    void drawRequests(key, n, first, count, track, sector)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Draw requests first to first + count - 1 of an experiment of n requests. Requests
+        2b and 2b + 1 take the words of Philox block (b mod 2^32, key.index, n, b / 2^32) under key
+        (key.seed, key.stream), so any run of requests is generated without the ones before it. The
+        blocks are produced in bulk by philoxBlocks into per-thread buffers.
+    parameters:
+        key     I/P  experimentKey  Experiment the requests belong to
+        n       I/P  uint32_t       Number of requests in the experiment (its low 32 bits for a stream)
+        first   I/P  long long      Index of the first request to draw
+        count   I/P  int            Number of requests to draw
+        track   O/P  int*           Tracks of the requests, count entries
+        sector  O/P  int*           Sectors of the requests, count entries
+*/
+void drawRequests(experimentKey key, uint32_t n, long long first, int count, int *track, int *sector)
+{
+    thread_local vector<uint32_t> words[4];
+    const uint64_t firstBlock = (uint64_t)first / 2, endBlock = ((uint64_t)first + count + 1) / 2;
+    const int blocks = (int)(endBlock - firstBlock);
+    for (vector<uint32_t> &w : words)
+        if ((int)w.size() < blocks)
+            w.resize(blocks);
+
+    // a run only crosses into the next 2^32 blocks in streams of billions of requests
+    for (uint64_t b = firstBlock; b < endBlock;)
+    {
+        uint64_t end = std::min(endBlock, (uint64_t)((b | 0xffffffffu) + 1));
+        size_t at = b - firstBlock;
+        philoxBlocks(key.seed, key.stream, (uint32_t)b, key.index, n, (uint32_t)(b >> 32), (int)(end - b),
+                     words[0].data() + at, words[1].data() + at, words[2].data() + at, words[3].data() + at);
+        b = end;
+    }
+
+    const int skip = (int)(first % 2); // an odd first request is the second half of its block
+    for (int k = 0; k < count; k++)
+    {
+        int r = k + skip, b = r / 2;
+        if (r % 2 == 0)
+            placeRequest(words[0][b], words[1][b], track[k], sector[k]);
+        else
+            placeRequest(words[2][b], words[3][b], track[k], sector[k]);
+    }
+}
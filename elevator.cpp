@@ -0,0 +1,176 @@
+/*
+file: elevator.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    appendRun - Append a run of sorted requests to a service plan, in either direction.
+    appendMove - Append a head movement that services nothing to a service plan.
+    firstAtOrAbove - Index of the first sorted request at or above a track.
+    planSweep - Build the service plan of a single-sweep elevator algorithm for a batch of requests.
+    planNStep - Build the service plan of N-step SCAN.
+*/
+
+/* Requests per sub-queue for N-step SCAN; set once from the command line before any run */
+int nstepSize = 10;
+
+/*
+    void appendRun(&plan, sorted, first, last, step)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Append sorted[first] through sorted[last] to a service plan, stepping by step. An
+        empty run (last one step behind first) appends nothing.
+    parameters:
+        &plan   I/P  reqBatch  Service plan being built
+        sorted  I/P  reqSpan   Requests sorted by track, then sector
+        first   I/P  int       Index of the first request to append
+        last    I/P  int       Index of the last request to append
+        step    I/P  int       1 for an upward run, -1 for a downward run
+*/
+inline void appendRun(reqBatch &plan, reqSpan sorted, int first, int last, int step)
+{
+    for (int i = first; i != last + step; i += step)
+        plan.push_back(sorted.track[i], sorted.sector[i]);
+}
+
+/*
+    void appendMove(&plan, track)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Append a head movement that services nothing to a service plan. Moves are stored as
+        a plan entry with sector -1; serviceSequence and the lane evaluator only seek for them.
+    parameters:
+        &plan  I/P  reqBatch  Service plan being built
+        track  I/P  int       Track the head moves to
+*/
+inline void appendMove(reqBatch &plan, int track)
+{
+    plan.push_back(track, -1);
+}
+
+/*
+    int firstAtOrAbove(sorted, track)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Index of the first sorted request at or above a track.
+    parameters:
+        sorted          I/P  reqSpan  Requests sorted by track, then sector
+        track           I/P  int      Track to compare against
+        firstAtOrAbove  O/P  int      Index of the first request with track >= track (size if none)
+*/
+inline int firstAtOrAbove(reqSpan sorted, int track)
+{
+    return (int)(lower_bound(sorted.track, sorted.track + sorted.size, track) - sorted.track);
+}
+
+/*
+    void planNStep(in, startTrack, &sorted, &plan)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Build the service plan of N-step SCAN. The requests are split, in arrival order, into
+        sub-queues of nstepSize. Each sub-queue is swept LOOK-style in full before the next one is
+        started, and the sweep direction carries over from one sub-queue to the next. The head starts
+        on startTrack moving towards higher tracks.
+    parameters:
+        in          I/P  reqSpan   View of simulated I/O requests, in arrival order
+        startTrack  I/P  int       Track the head starts on
+        &sorted     I/P  reqBatch  Scratch batch for the sorted sub-queue
+        &plan       O/P  reqBatch  Service plan
+*/
+void planNStep(reqSpan in, int startTrack, reqBatch &sorted, reqBatch &plan)
+{
+    plan.clear();
+    int headTrack = startTrack;
+    bool ascending = true;
+
+    for (int first = 0; first < in.size; first += nstepSize)
+    {
+        int m = min(nstepSize, in.size - first);
+        sortRequests(reqSpan{in.track + first, in.sector + first, m}, sorted);
+        reqSpan sub = sorted.span();
+
+        if (ascending)
+        {
+            int s = firstAtOrAbove(sub, headTrack);
+            appendRun(plan, sub, s, m - 1, 1);
+            appendRun(plan, sub, s - 1, 0, -1);
+            if (s > 0)
+                ascending = false;
+        }
+        else
+        {
+            int s = firstAtOrAbove(sub, headTrack + 1);
+            appendRun(plan, sub, s - 1, 0, -1);
+            appendRun(plan, sub, s, m - 1, 1);
+            if (s < m)
+                ascending = true;
+        }
+        headTrack = plan.track.back();
+    }
+}
+
+/* How a single-sweep elevator algorithm turns around (see planSweep). Each finishes a plan whose
+   upward pass has served sorted[start] onwards, by serving sorted[0] through sorted[start - 1]. */
+
+/* SCAN: on to the last track of the disk, then back down */
+struct scanTurn
+{
+    static void finish(reqBatch &plan, reqSpan req, int start)
+    {
+        appendMove(plan, drive.tracks - 1);
+        appendRun(plan, req, start - 1, 0, -1);
+    }
+};
+
+/* C-SCAN: on to the last track, return to track 0, then up again */
+struct cscanTurn
+{
+    static void finish(reqBatch &plan, reqSpan req, int start)
+    {
+        appendMove(plan, drive.tracks - 1);
+        appendMove(plan, 0);
+        appendRun(plan, req, 0, start - 1, 1);
+    }
+};
+
+/* LOOK: turn at the last request and come back down */
+struct lookTurn
+{
+    static void finish(reqBatch &plan, reqSpan req, int start) { appendRun(plan, req, start - 1, 0, -1); }
+};
+
+/* C-LOOK: jump from the last request to the lowest one, then up again */
+struct clookTurn
+{
+    static void finish(reqBatch &plan, reqSpan req, int start) { appendRun(plan, req, 0, start - 1, 1); }
+};
+
+/*
+    void planSweep<Turn>(in, startTrack, &sorted, &plan)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Build the service plan of a single-sweep elevator algorithm for a batch of
+        requests. The head starts on startTrack moving towards higher tracks and serves every
+        request at or above it; Turn then serves the rest (scanTurn, cscanTurn, lookTurn,
+        clookTurn). The plan holds every request once, plus at most two head moves (sector -1).
+    parameters:
+        Turn        I/P  class     How the sweep turns around
+        in          I/P  reqSpan   View of simulated I/O requests
+        startTrack  I/P  int       Track the head starts on
+        &sorted     I/P  reqBatch  Scratch batch for the sorted requests
+        &plan       O/P  reqBatch  Service plan
+*/
+template <class Turn>
+void planSweep(reqSpan in, int startTrack, reqBatch &sorted, reqBatch &plan)
+{
+    plan.clear();
+    sortRequests(in, sorted);
+    reqSpan req = sorted.span();
+    const int start = firstAtOrAbove(req, startTrack);
+
+    // every variant starts with the upward pass
+    appendRun(plan, req, start, req.size - 1, 1);
+    if (start > 0)
+        Turn::finish(plan, req, start);
+}
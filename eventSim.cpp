@@ -0,0 +1,566 @@
+/*
+file: eventSim.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    eventCalendar::push - Add an event to the calendar.
+    eventCalendar::pop - Remove and return the earliest event.
+    arrivalProcess - Constructor method that sets up an arrival stream.
+    arrivalProcess::next - Produce the next request arrival.
+    fifoQueue, lifoQueue, sstfQueue, elevatorQueue, nstepQueue, fscanQueue - Pending request sets
+        that each pick in their own order.
+    lookPick - Take the next request of a LOOK sweep from an ordered request set.
+    runEventSim - Run an open-loop discrete-event simulation of one drive.
+*/
+
+#include <deque>
+#include <set>
+#include <memory>
+
+/* One I/O request together with the time it arrived at the drive */
+struct timedReq
+{
+    double arrival;             // Arrival time in milliseconds
+    int track;                  // Track value of the request
+    int sector;                 // Sector value of the request
+    uint64_t tag = 0;           // Caller's handle for the request (onlineScheduler); 0 when it has none
+};
+
+/* Kinds of event the engine handles */
+enum eventType
+{
+    EV_ARRIVAL,
+    EV_COMPLETION
+};
+
+/* One entry on the event calendar */
+struct simEvent
+{
+    double time;                // Time the event fires in milliseconds
+    eventType type;             // What happens at that time
+};
+
+/* Event list ordered by time; a binary heap on a vector that keeps its storage between runs */
+class eventCalendar
+{
+public:
+    void push(simEvent e);
+    simEvent pop();
+    bool empty() const { return heap.empty(); }
+
+private:
+    static bool later(const simEvent &a, const simEvent &b) { return a.time > b.time; }
+    std::vector<simEvent> heap;
+};
+
+/* Settings for the arrival process and run length */
+struct arrivalConfig
+{
+    char kind;                  // 'p' Poisson, 'b' bursty (on/off), 'r' trace replay
+    double rate;                // Mean arrival rate in requests per second
+    double burstOn;             // Bursty: mean length of an on period in ms
+    double burstOff;            // Bursty: mean length of an off period in ms
+    double horizon;             // Arrivals stop after this many ms
+    unsigned seed;              // Randomization seed
+    const traceFile *trace;     // Replay: mapped trace file
+    char traceFormat;           // Replay: 'b' blkparse or 'm' MSR CSV
+    uint64_t traceSpan;         // Replay: traced device size in bytes for mapLba (0 wraps)
+};
+
+/* Generator of request arrivals */
+class arrivalProcess
+{
+public:
+    arrivalProcess(const arrivalConfig &cfg);
+    bool next(timedReq &r);
+
+private:
+    arrivalConfig cfg;
+    philoxEngine gen;           // Gaps and placements, keyed (seed, STREAM_ARRIVALS)
+    std::exponential_distribution<double> gap;
+    double now;                 // Time of the last arrival
+    double phaseEnd;            // Bursty: end of the current on period
+    std::unique_ptr<traceReader> reader; // Replay: this stream's position in the trace
+};
+
+/* Statistics from one event simulation */
+struct eventResults
+{
+    long long completed;        // Requests serviced
+    long long events;           // Events processed
+    double meanResponse;        // Mean time from arrival to completion in ms
+    double meanWait;            // Mean time from arrival to start of service in ms
+    double maxResponse;         // Largest response time in ms
+    double utilization;         // Fraction of time the drive was busy
+    double throughput;          // Completed requests per second of simulated time
+    double wallSeconds;         // Real time the simulation took
+    latencySummary response;    // Response time percentiles in ms
+};
+
+/*
+    void push(e)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Add an event to the calendar.
+    parameters:
+        e  I/P  simEvent  Event to add
+*/
+void eventCalendar::push(simEvent e)
+{
+    heap.push_back(e);
+    std::push_heap(heap.begin(), heap.end(), later);
+}
+
+/*
+    simEvent pop()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Remove and return the earliest event. The calendar must not be empty.
+    parameters:
+        pop  O/P  simEvent  Earliest event
+*/
+simEvent eventCalendar::pop()
+{
+    std::pop_heap(heap.begin(), heap.end(), later);
+    simEvent e = heap.back();
+    heap.pop_back();
+    return e;
+}
+
+/*
+    arrivalProcess(cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that sets up an arrival stream. Poisson arrivals have
+        exponential gaps at cfg.rate. Bursty arrivals alternate exponentially long on and off
+        periods; arrivals only happen while on, at a rate raised so the long-run mean is still
+        cfg.rate. Replay streams the records of cfg.trace in order, each with its own reader, so
+        every algorithm can replay the same mapped file at once.
+    parameters:
+        cfg  I/P  arrivalConfig  Arrival settings
+*/
+arrivalProcess::arrivalProcess(const arrivalConfig &c)
+    : cfg(c), gen(c.seed, STREAM_ARRIVALS), now(0), phaseEnd(0)
+{
+    if (cfg.kind == 'r')
+        reader.reset(new traceReader(*cfg.trace, cfg.traceFormat));
+
+    double perMs = cfg.rate / 1000;
+    if (cfg.kind == 'b')
+        perMs *= (cfg.burstOn + cfg.burstOff) / cfg.burstOn;
+    gap = std::exponential_distribution<double>(perMs);
+
+    if (cfg.kind == 'b')
+        phaseEnd = std::exponential_distribution<double>(1 / cfg.burstOn)(gen);
+}
+
+/*
+    bool next(&r)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Produce the next request arrival.
+    parameters:
+        &r    O/P  timedReq  The next request
+        next  O/P  bool      False once the stream has ended or passed the horizon
+*/
+bool arrivalProcess::next(timedReq &r)
+{
+    if (cfg.kind == 'r')
+    {
+        traceRecord t;
+        if (!reader->next(t))
+            return false;
+        r.arrival = t.time;
+        mapLba(t.offset, cfg.traceSpan, r.track, r.sector);
+        return r.arrival <= cfg.horizon;
+    }
+
+    now += gap(gen);
+    if (cfg.kind == 'b')
+    {
+        // an arrival that falls past the on period is pushed into the next one
+        while (now > phaseEnd)
+        {
+            double off = std::exponential_distribution<double>(1 / cfg.burstOff)(gen);
+            double on = std::exponential_distribution<double>(1 / cfg.burstOn)(gen);
+            now += off;
+            phaseEnd += off + on;
+        }
+    }
+
+    r.arrival = now;
+    drawRequest(gen, r.track, r.sector);
+    return now <= cfg.horizon;
+}
+
+/* Every queue offers add, pick and empty. detour returns a track the head must travel to, servicing
+   nothing, before the next pick (-1 for none); only the sweeps that run to the disk edge use it. */
+
+/* FIFO: serve in arrival order */
+class fifoQueue
+{
+public:
+    void add(const timedReq &r) { q.push_back(r); }
+    int detour(const headState &) { return -1; }
+    timedReq pick(const headState &)
+    {
+        timedReq r = q.front();
+        q.pop_front();
+        return r;
+    }
+    bool empty() const { return q.empty(); }
+
+private:
+    std::deque<timedReq> q;
+};
+
+/* LIFO: serve the most recent arrival */
+class lifoQueue
+{
+public:
+    void add(const timedReq &r) { q.push_back(r); }
+    int detour(const headState &) { return -1; }
+    timedReq pick(const headState &)
+    {
+        timedReq r = q.back();
+        q.pop_back();
+        return r;
+    }
+    bool empty() const { return q.empty(); }
+
+private:
+    std::vector<timedReq> q;
+};
+
+/* Pending requests ordered by track, then sector, then arrival */
+struct keyOrder
+{
+    bool operator()(const timedReq &a, const timedReq &b) const
+    {
+        if (a.track != b.track)
+            return a.track < b.track;
+        if (a.sector != b.sector)
+            return a.sector < b.sector;
+        return a.arrival < b.arrival;
+    }
+};
+typedef std::multiset<timedReq, keyOrder> orderedReqs;
+
+/* SSTF: serve the pending request on the nearest track, and on it the one whose sector comes round
+   first. The non-empty tracks are marked in an occupancy bitmap; each track keeps a bitmap of its
+   sectors with pending requests and a FIFO list of the requests on each sector, linked through a
+   shared node pool. A pick is a nearest-set-bit search over the tracks and a find-next-set-bit from
+   the sector under the head (wrapping round to sector 0), so it takes O(log tracks + log sectors)
+   however many requests are pending, and requests on the same sector are served in arrival order. */
+class sstfQueue
+{
+public:
+    sstfQueue() : tracks(drive.tracks) { occ.reset(drive.tracks); }
+    void add(const timedReq &r)
+    {
+        trackQueue &q = tracks[r.track];
+        if (q.first.empty())
+        {
+            // a track's sector lists are laid out the first time a request lands on it
+            const int sectors = drive.sectorsOn(r.track);
+            q.sectors.reset(sectors);
+            q.first.assign(sectors, -1);
+            q.last.assign(sectors, -1);
+        }
+
+        int n = freeNode;
+        if (n >= 0)
+            freeNode = nodes[n].next;
+        else
+        {
+            n = (int)nodes.size();
+            nodes.emplace_back();
+        }
+        nodes[n] = node{r, -1};
+
+        if (q.first[r.sector] < 0)
+        {
+            q.first[r.sector] = n;
+            q.sectors.set(r.sector);
+        }
+        else
+            nodes[q.last[r.sector]].next = n;
+        q.last[r.sector] = n;
+        occ.set(r.track);
+    }
+    int detour(const headState &) { return -1; }
+    timedReq pick(const headState &head)
+    {
+        const int t = nearestTrack(occ, head.track);
+        trackQueue &q = tracks[t];
+        int s = q.sectors.nextSet(sectorAfterSeek(head, t));
+        if (s < 0)
+            s = q.sectors.nextSet(0);
+
+        const int n = q.first[s];
+        timedReq r = nodes[n].r;
+        q.first[s] = nodes[n].next;
+        nodes[n].next = freeNode;
+        freeNode = n;
+        if (q.first[s] < 0)
+        {
+            q.sectors.clear(s);
+            if (!q.sectors.any())
+                occ.clear(t);
+        }
+        return r;
+    }
+    bool empty() const { return !occ.any(); }
+
+private:
+    struct node
+    {
+        timedReq r;
+        int next;               // Next request on the same sector, or next free node; -1 for none
+    };
+    struct trackQueue
+    {
+        occupancyBitmap sectors;    // Sectors with pending requests
+        std::vector<int> first;     // Oldest pending request on each sector, -1 for none
+        std::vector<int> last;      // Newest pending request on each sector, valid while first is
+    };
+
+    std::vector<trackQueue> tracks;
+    std::vector<node> nodes;
+    int freeNode = -1;          // Head of the list of nodes free for reuse
+    occupancyBitmap occ;
+};
+
+/*
+    orderedReqs::iterator lookPick(&q, track, &ascending)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Find the next request of a LOOK sweep: the first request at or above the head when
+        moving up, the last one at or below it when moving down. The sweep turns around when nothing
+        is left ahead of the head. q must not be empty.
+    parameters:
+        &q          I/P  orderedReqs  Pending requests
+        track       I/P  int          Track the head is over
+        &ascending  I/P  bool         Sweep direction; flipped when the sweep turns around
+        lookPick    O/P  iterator     Request to service next
+*/
+orderedReqs::iterator lookPick(orderedReqs &q, int track, bool &ascending)
+{
+    orderedReqs::iterator it;
+    if (ascending)
+    {
+        it = q.lower_bound(timedReq{-1, track, -1});
+        if (it == q.end())
+        {
+            ascending = false;
+            it = std::prev(q.end());
+        }
+    }
+    else
+    {
+        it = q.lower_bound(timedReq{-1, track + 1, -1});
+        if (it == q.begin())
+            ascending = true;
+        else
+            --it;
+    }
+    return it;
+}
+
+/* SCAN, C-SCAN, LOOK and C-LOOK. toEdge sweeps run on to the last (or first) track before turning;
+   circular sweeps only serve on the way up and return to the low end once the top is reached. */
+class elevatorQueue
+{
+public:
+    elevatorQueue(bool toEdge, bool circular) : toEdge(toEdge), circular(circular) {}
+    void add(const timedReq &r) { q.insert(r); }
+    int detour(const headState &head)
+    {
+        if (!toEdge)
+            return -1;
+        if (ascending || circular)
+        {
+            if (q.lower_bound(timedReq{-1, head.track, -1}) != q.end())
+                return -1;
+            if (head.track != drive.tracks - 1)
+                return drive.tracks - 1;
+            return circular ? 0 : -1;
+        }
+        if (q.lower_bound(timedReq{-1, head.track + 1, -1}) != q.begin() || head.track == 0)
+            return -1;
+        return 0;
+    }
+    timedReq pick(const headState &head)
+    {
+        orderedReqs::iterator it;
+        if (circular)
+        {
+            it = q.lower_bound(timedReq{-1, head.track, -1});
+            if (it == q.end())
+                it = q.begin();
+        }
+        else
+            it = lookPick(q, head.track, ascending);
+        timedReq r = *it;
+        q.erase(it);
+        return r;
+    }
+    bool empty() const { return q.empty(); }
+
+private:
+    orderedReqs q;
+    bool toEdge, circular;
+    bool ascending = true;
+};
+
+/* N-step SCAN: arrivals join a FIFO; the first N of them are taken as a sub-queue that is swept in
+   full, LOOK-style, before the next N are taken */
+class nstepQueue
+{
+public:
+    nstepQueue(int n) : n(n) {}
+    void add(const timedReq &r) { incoming.push_back(r); }
+    int detour(const headState &) { return -1; }
+    timedReq pick(const headState &head)
+    {
+        if (active.empty())
+        {
+            for (int i = 0; i < n && !incoming.empty(); i++)
+            {
+                active.insert(incoming.front());
+                incoming.pop_front();
+            }
+        }
+        orderedReqs::iterator it = lookPick(active, head.track, ascending);
+        timedReq r = *it;
+        active.erase(it);
+        return r;
+    }
+    bool empty() const { return active.empty() && incoming.empty(); }
+
+private:
+    int n;
+    std::deque<timedReq> incoming;
+    orderedReqs active;
+    bool ascending = true;
+};
+
+/* FSCAN: the sweep serves a frozen queue while new arrivals collect in a second one, which is
+   frozen in turn once the sweep has drained the first */
+class fscanQueue
+{
+public:
+    void add(const timedReq &r) { waiting.insert(r); }
+    int detour(const headState &) { return -1; }
+    timedReq pick(const headState &head)
+    {
+        if (active.empty())
+            active.swap(waiting);
+        orderedReqs::iterator it = lookPick(active, head.track, ascending);
+        timedReq r = *it;
+        active.erase(it);
+        return r;
+    }
+    bool empty() const { return active.empty() && waiting.empty(); }
+
+private:
+    orderedReqs active, waiting;
+    bool ascending = true;
+};
+
+/*
+    eventResults runEventSim(arrivals, &queue)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run an open-loop discrete-event simulation of one drive. Requests arrive over time
+        from the arrival process and wait in the queue. Whenever the drive is idle and requests are
+        pending, the head first makes any detour the queue asks for, then the queue picks the next
+        request given the current head position, and it is serviced with serviceRequest. The run
+        ends once the arrivals have stopped and the queue is drained. Event times are kept in
+        double; the head clock only needs the time within the model's rotation period, which keeps
+        it accurate over hours of simulated time.
+    parameters:
+        arrivals     I/P  arrivalConfig  Arrival settings
+        &queue       I/P  Queue          Empty pending request set (fifoQueue, sstfQueue, ...)
+        runEventSim  O/P  eventResults   Response time and throughput statistics
+*/
+template <class Queue>
+eventResults runEventSim(const arrivalConfig &arrivals, Queue &queue)
+{
+    const double rotationPeriod = drive.rotationPeriod;
+    std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+
+    arrivalProcess source(arrivals);
+    eventCalendar calendar;
+    headState head = startHead();
+    bool busy = false;
+    timedReq inService = {0, 0, 0}, pending;
+    double serviceStart = 0, busyTime = 0, now = 0;
+
+    eventResults res = {0, 0, 0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0}};
+    double responseSum = 0, waitSum = 0;
+    latencyHist responses;
+
+    bool more = source.next(pending);
+    if (more)
+        calendar.push(simEvent{pending.arrival, EV_ARRIVAL});
+
+    auto startService = [&]() {
+        head.clock = (float)fmod(now, rotationPeriod);
+        double elapsed = 0;
+        for (int d = queue.detour(head); d >= 0; d = queue.detour(head))
+            elapsed += drive.seekTable[moveHead(head, d)];
+
+        inService = queue.pick(head);
+        serviceCost c = serviceRequest(head, inService.track, inService.sector);
+        elapsed += c.seek + c.rotation + c.transfer;
+        serviceStart = now;
+        busy = true;
+        calendar.push(simEvent{now + elapsed, EV_COMPLETION});
+    };
+
+    while (!calendar.empty())
+    {
+        simEvent ev = calendar.pop();
+        now = ev.time;
+        res.events++;
+
+        if (ev.type == EV_ARRIVAL)
+        {
+            queue.add(pending);
+            more = source.next(pending);
+            if (more)
+                calendar.push(simEvent{pending.arrival, EV_ARRIVAL});
+        }
+        else
+        {
+            double response = now - inService.arrival;
+            responseSum += response;
+            responses.record((float)response);
+            waitSum += serviceStart - inService.arrival;
+            res.maxResponse = max(res.maxResponse, response);
+            busyTime += now - serviceStart;
+            res.completed++;
+            busy = false;
+        }
+
+        if (!busy && !queue.empty())
+            startService();
+    }
+
+    if (res.completed > 0)
+    {
+        res.meanResponse = responseSum / res.completed;
+        res.meanWait = waitSum / res.completed;
+    }
+    if (now > 0)
+    {
+        res.utilization = busyTime / now;
+        res.throughput = res.completed / (now / 1000);
+    }
+    res.response = responses.summary();
+    res.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return res;
+}
@@ -0,0 +1,456 @@
+/*
+file: hddBench.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    main - Run the selected benchmarks and print the results as JSON.
+    parseBenchArgs - Read the benchmark options.
+    measure - Time repeated runs of one benchmark case after warming up.
+    summarize - Summary statistics of the per-repetition timings.
+    loadBaseline - Read the medians of an earlier run's JSON output.
+    printCase - Print one benchmark case as a JSON object.
+
+Build and run:
+    g++ -O2 -pthread hddBench.cpp -o hddBench
+    ./hddBench > bench.json
+    ./hddBench --compare bench.json     (exits 1 if a case got slower than the threshold)
+*/
+
+#define HDDSIM_NO_MAIN
+#include "hddSim.cpp"
+
+#include <cstdio>
+#include <map>
+
+/* Options of a benchmark run */
+struct benchConfig
+{
+    simConfig sim;              // Threads, algorithms, lanes and drive used by the cases
+    vector<int> sizes;          // Batch sizes for the generate, sort and scheduler cases
+    bool cases[6];              // Which of generate, sort, sched, sweep, array and online to run
+    int warmup;                 // Untimed repetitions before measuring
+    int reps;                   // Timed repetitions
+    double minRepMs;            // A repetition loops the case until it has run at least this long
+    const char *drivePath;      // Drive config in use, or null for the built-in drive
+    const char *baseline;       // Earlier JSON output to compare against, or null
+    double threshold;           // Relative slowdown in the median that counts as a regression
+    int producers;              // Submitting threads in the online case
+};
+
+/* Summary of one case's per-request timings over the repetitions */
+struct benchStats
+{
+    double median;              // Median ns per request
+    double mean;                // Mean ns per request
+    double stddev;              // Sample standard deviation of ns per request
+    double min;                 // Fastest repetition
+    double max;                 // Slowest repetition
+    long long iterations;       // Runs of the case per repetition
+};
+
+enum benchCase { CASE_GENERATE, CASE_SORT, CASE_SCHED, CASE_SWEEP, CASE_ARRAY, CASE_ONLINE };
+const char *CASE_NAMES[6] = {"generate", "sort", "sched", "sweep", "array", "online"};
+
+/* The array case streams ARRAY_BENCH_REQUESTS requests over a RAID-0 of ARRAY_BENCH_DISKS drives;
+   run it at several -t to see how the per-drive engines scale */
+#define ARRAY_BENCH_REQUESTS 262144
+#define ARRAY_BENCH_DISKS 16
+
+/* The online case submits ONLINE_BENCH_REQUESTS requests from --producers threads to an
+   onlineScheduler with an ONLINE_BENCH_CAPACITY ring, choosing among ONLINE_BENCH_DEPTH at a time */
+#define ONLINE_BENCH_REQUESTS 262144
+#define ONLINE_BENCH_CAPACITY 4096
+#define ONLINE_BENCH_DEPTH 256
+
+/* Results are kept live through this so the compiler cannot drop the work being timed */
+volatile float benchSink;
+
+/*
+    benchConfig parseBenchArgs(argc, argv)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Read the benchmark options. Supported options:
+        -t, --threads N   threads for the sweep and array cases (default: one per hardware thread)
+        -a, --algs LIST   algorithms to benchmark, or "all" (default all)
+        -s, --scalar      benchmark the sweep without SIMD lane groups
+        --drive FILE      simulate the drive described in FILE
+        --cache N         give the drive a cache of N segments (see driveCache) in every case
+        --sizes LIST      comma separated batch sizes (default 50,500,5000,50000,500000,5000000,10000000)
+        --cases LIST      any of generate,sort,sched,sweep,array,online (default all six)
+        --producers P     submitting threads in the online case (default 4)
+        --warmup W        untimed repetitions per case, the first one a single sizing run (default 1)
+        --reps R          timed repetitions per case (default 5)
+        --min-time MS     shortest repetition; short cases are looped to reach it (default 20)
+        --compare FILE    report each case's change against an earlier run's JSON output
+        --threshold F     with --compare, a median slowdown above F (default 0.10) is a regression
+    parameters:
+        argc            I/P  int          Number of command line arguments
+        argv            I/P  char**       Command line arguments
+        parseBenchArgs  O/P  benchConfig  Parsed options
+*/
+benchConfig parseBenchArgs(int argc, char *argv[])
+{
+    benchConfig cfg;
+    cfg.sim = parseArgs(1, argv);
+    cfg.sim.algs.clear();
+    for (int a = 0; a < (int)schedRegistry().size(); a++)
+        cfg.sim.algs.push_back(a);
+    cfg.sizes = {50, 500, 5000, 50000, 500000, 5000000, 10000000};
+    fill(cfg.cases, cfg.cases + 6, true);
+    cfg.warmup = 1;
+    cfg.reps = 5;
+    cfg.minRepMs = 20;
+    cfg.drivePath = nullptr;
+    cfg.baseline = nullptr;
+    cfg.threshold = 0.10;
+    cfg.producers = 4;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--threads") == 0) && i + 1 < argc)
+            cfg.sim.threads = max(1, atoi(argv[++i]));
+        else if ((strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--algs") == 0) && i + 1 < argc)
+            cfg.sim.algs = parseAlgs(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--scalar") == 0)
+            cfg.sim.lanes = false;
+        else if (strcmp(argv[i], "--drive") == 0 && i + 1 < argc)
+        {
+            cfg.drivePath = argv[++i];
+            if (!loadDriveModel(cfg.drivePath, drive))
+                exit(1);
+        }
+        else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc)
+            cacheSettings.segments = max(0, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc)
+        {
+            cfg.sizes.clear();
+            char *end = argv[++i];
+            do
+                cfg.sizes.push_back(max(1, (int)strtod(end + (*end == ','), &end)));
+            while (*end == ',');
+        }
+        else if (strcmp(argv[i], "--cases") == 0 && i + 1 < argc)
+        {
+            fill(cfg.cases, cfg.cases + 6, false);
+            string list = argv[++i];
+            for (int c = 0; c < 6; c++)
+                cfg.cases[c] = ("," + list + ",").find(string(",") + CASE_NAMES[c] + ",") != string::npos;
+        }
+        else if (strcmp(argv[i], "--producers") == 0 && i + 1 < argc)
+            cfg.producers = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+            cfg.warmup = max(0, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc)
+            cfg.reps = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+            cfg.minRepMs = atof(argv[++i]);
+        else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc)
+            cfg.baseline = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+            cfg.threshold = atof(argv[++i]);
+        else
+        {
+            cerr << "usage: " << argv[0] << " [-t threads] [-a algs] [-s] [--drive FILE] [--cache N] [--sizes LIST] [--cases LIST]"
+                 << " [--producers P] [--warmup W] [--reps R] [--min-time MS] [--compare FILE [--threshold F]]\n";
+            exit(1);
+        }
+    }
+    return cfg;
+}
+
+/*
+    benchStats summarize(nsPerRequest, iterations)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Summary statistics of the per-repetition timings.
+    parameters:
+        nsPerRequest  I/P  vector<double>  ns per request of each repetition
+        iterations    I/P  long long       Runs of the case per repetition
+        summarize     O/P  benchStats      Median, mean, standard deviation, min and max
+*/
+benchStats summarize(vector<double> nsPerRequest, long long iterations)
+{
+    benchStats s;
+    sort(nsPerRequest.begin(), nsPerRequest.end());
+    const size_t r = nsPerRequest.size();
+    s.median = r % 2 ? nsPerRequest[r / 2] : (nsPerRequest[r / 2 - 1] + nsPerRequest[r / 2]) / 2;
+    s.min = nsPerRequest.front();
+    s.max = nsPerRequest.back();
+    s.mean = 0;
+    for (double v : nsPerRequest)
+        s.mean += v;
+    s.mean /= r;
+    double sq = 0;
+    for (double v : nsPerRequest)
+        sq += (v - s.mean) * (v - s.mean);
+    s.stddev = r > 1 ? sqrt(sq / (r - 1)) : 0;
+    s.iterations = iterations;
+    return s;
+}
+
+/*
+    benchStats measure(cfg, requestsPerRun, run)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Time repeated runs of one benchmark case after warming up. The first warmup run is
+        also timed to decide how many runs a repetition loops over, so every repetition lasts at
+        least cfg.minRepMs and short cases are not lost in timer resolution.
+    parameters:
+        cfg             I/P  benchConfig  Benchmark options
+        requestsPerRun  I/P  double       Requests handled by one run of the case
+        run             I/P  function     Runs the case once; called with the run number
+        measure         O/P  benchStats   ns per request over the timed repetitions
+*/
+benchStats measure(const benchConfig &cfg, double requestsPerRun, const function<void(long long)> &run)
+{
+    typedef chrono::steady_clock clk;
+    long long counter = 0;
+
+    // calibrate on one run, then warm up with whole repetitions
+    clk::time_point t0 = clk::now();
+    run(counter++);
+    double once = chrono::duration<double, milli>(clk::now() - t0).count();
+    long long iterations = once >= cfg.minRepMs ? 1 : (long long)ceil(cfg.minRepMs / max(once, 1e-4));
+    for (int w = 1; w < cfg.warmup; w++)
+        for (long long k = 0; k < iterations; k++)
+            run(counter++);
+
+    vector<double> nsPerRequest;
+    for (int r = 0; r < cfg.reps; r++)
+    {
+        clk::time_point start = clk::now();
+        for (long long k = 0; k < iterations; k++)
+            run(counter++);
+        double ns = chrono::duration<double, nano>(clk::now() - start).count();
+        nsPerRequest.push_back(ns / (iterations * requestsPerRun));
+    }
+    return summarize(nsPerRequest, iterations);
+}
+
+/*
+    map<string, double> loadBaseline(path)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Read the medians of an earlier run's JSON output. Only the layout printCase writes
+        (one case per line) is understood.
+    parameters:
+        path          I/P  char*                Earlier output of this benchmark
+        loadBaseline  O/P  map<string, double>  Median ns per request keyed by "case/name/n"
+*/
+map<string, double> loadBaseline(const char *path)
+{
+    map<string, double> medians;
+    ifstream in(path);
+    if (!in)
+    {
+        cerr << "cannot read baseline: " << path << "\n";
+        exit(1);
+    }
+    string line;
+    while (getline(in, line))
+    {
+        size_t at = line.find("{\"case\"");
+        if (at == string::npos)
+            continue;
+        char kind[32], name[64];
+        long long n, iterations;
+        double median;
+        if (sscanf(line.c_str() + at, "{\"case\": \"%31[^\"]\", \"name\": \"%63[^\"]\", \"n\": %lld, \"iterations\": %lld, "
+                                      "\"ns_per_request\": {\"median\": %lf",
+                   kind, name, &n, &iterations, &median) == 5)
+            medians[string(kind) + "/" + name + "/" + to_string(n)] = median;
+    }
+    return medians;
+}
+
+/*
+    bool printCase(kind, name, n, s, baseline, threshold, first, extra)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Print one benchmark case as a JSON object on its own line. Fields a case adds of
+        its own come after the timings. With a baseline, the baseline median and the relative
+        change are added.
+    parameters:
+        kind       I/P  char*                Case kind (generate, sort, sched, sweep, array, online)
+        name       I/P  char*                Algorithm name, or the kind for the other cases
+        n          I/P  long long            Requests per run
+        s          I/P  benchStats           Timings of the case
+        baseline   I/P  map<string, double>  Medians of an earlier run, possibly empty
+        threshold  I/P  double               Relative slowdown that counts as a regression
+        first      I/P  bool                 True for the first case (no leading comma)
+        extra      I/P  char*                Further JSON fields, each led by ", " (none by default)
+        printCase  O/P  bool                 True if the case regressed against the baseline
+*/
+bool printCase(const char *kind, const char *name, long long n, const benchStats &s, const map<string, double> &baseline,
+               double threshold, bool first, const char *extra = "")
+{
+    printf("%s\n    {\"case\": \"%s\", \"name\": \"%s\", \"n\": %lld, \"iterations\": %lld, "
+           "\"ns_per_request\": {\"median\": %.4f, \"mean\": %.4f, \"stddev\": %.4f, \"min\": %.4f, \"max\": %.4f}, "
+           "\"requests_per_second\": %.6e",
+           first ? "" : ",", kind, name, n, s.iterations, s.median, s.mean, s.stddev, s.min, s.max, 1e9 / s.median);
+    printf("%s", extra);
+
+    bool regressed = false;
+    map<string, double>::const_iterator b = baseline.find(string(kind) + "/" + name + "/" + to_string(n));
+    if (b != baseline.end())
+    {
+        double change = s.median / b->second - 1;
+        regressed = change > threshold;
+        printf(", \"baseline_median\": %.4f, \"change\": %.4f, \"regression\": %s", b->second, change,
+               regressed ? "true" : "false");
+    }
+    printf("}");
+    return regressed;
+}
+
+/*
+    int main(argc, argv)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run the selected benchmarks and print the results as JSON. The cases are
+        generateRequests, sortRequests and every selected scheduler's run at each batch size, and
+        the full executeAlg sweep of every selected scheduler (EXPERIMENTS experiments at each of
+        50 to 150 requests), a streamed RAID-0 array and an onlineStress run of every selected
+        scheduler. An online run starts threads of its own and is long enough to time on its own,
+        so each repetition is one run; its submit, dispatch and latency figures are those of the
+        median repetition.
+    parameters:
+        argc  I/P  int     Number of command line arguments
+        argv  I/P  char**  Command line arguments (see parseBenchArgs)
+        main  O/P  int     1 if a case regressed against the --compare baseline, else 0
+*/
+int main(int argc, char *argv[])
+{
+    benchConfig cfg = parseBenchArgs(argc, argv);
+    map<string, double> baseline;
+    if (cfg.baseline)
+        baseline = loadBaseline(cfg.baseline);
+    threadPool pool(cfg.sim.threads);
+    sortPool = &pool;   // sorts made on this thread outside the pool's runs may use it
+    const vector<schedEntry> &policies = schedRegistry();
+    showProgress = false;
+
+    printf("{\n  \"benchmark\": \"hddSim\",\n  \"threads\": %d,\n  \"lanes\": %s,\n  \"lane_width\": %d,\n"
+           "  \"drive\": \"%s\",\n  \"cache_segments\": %d,\n  \"warmup\": %d,\n  \"repetitions\": %d,\n  \"results\": [",
+           cfg.sim.threads, cfg.sim.lanes ? "true" : "false", LANES, cfg.drivePath ? cfg.drivePath : "built-in",
+           cacheSettings.segments, cfg.warmup, cfg.reps);
+
+    // the sched cases run on this thread; each run starts from an empty cache like an experiment
+    driveCache cache;
+    if (cacheSettings.segments > 0)
+    {
+        cache.clear();
+        activeCache = &cache;
+    }
+
+    bool first = true, regressed = false;
+    reqBatch batch, sorted;
+    for (int n : cfg.sizes)
+    {
+        if (!cfg.cases[CASE_GENERATE] && !cfg.cases[CASE_SORT] && !cfg.cases[CASE_SCHED])
+            break;
+        generateRequests(n, experimentKey{1, STREAM_SHARED, 0}, batch);
+
+        if (cfg.cases[CASE_GENERATE])
+        {
+            reqBatch scratch;
+            benchStats s = measure(cfg, n, [&](long long k) {
+                generateRequests(n, experimentKey{1, STREAM_SHARED, (uint32_t)k}, scratch);
+                benchSink = (float)scratch.track[0];
+            });
+            regressed |= printCase("generate", "generate", n, s, baseline, cfg.threshold, first);
+            first = false;
+        }
+
+        if (cfg.cases[CASE_SORT])
+        {
+            benchStats s = measure(cfg, n, [&](long long) {
+                sortRequests(batch.span(), sorted);
+                benchSink = (float)sorted.track[0];
+            });
+            regressed |= printCase("sort", "sort", n, s, baseline, cfg.threshold, first);
+            first = false;
+        }
+
+        if (cfg.cases[CASE_SCHED])
+        {
+            for (int a : cfg.sim.algs)
+            {
+                benchStats s = measure(cfg, n, [&](long long) {
+                    if (activeCache)
+                        activeCache->clear();
+                    benchSink = policies[a].run(batch.span()).totalTime;
+                });
+                regressed |= printCase("sched", policies[a].name, n, s, baseline, cfg.threshold, first);
+                first = false;
+            }
+        }
+        fflush(stdout);
+    }
+
+    if (cfg.cases[CASE_SWEEP])
+    {
+        long long sweepRequests = 0;
+        for (int io = 50; io <= 150; io += 10)
+            sweepRequests += (long long)io * EXPERIMENTS;
+        for (int a : cfg.sim.algs)
+        {
+            benchStats s = measure(cfg, (double)sweepRequests, [&](long long) {
+                benchSink = policies[a].sweep(cfg.sim, pool)[0].avgReqTime;
+            });
+            regressed |= printCase("sweep", policies[a].name, sweepRequests, s, baseline, cfg.threshold, first);
+            first = false;
+        }
+    }
+
+    if (cfg.cases[CASE_ARRAY])
+    {
+        arrayConfig array{RAID_0, ARRAY_BENCH_DISKS, 16, 0};
+        streamConfig stream = cfg.sim.stream;
+        stream.requests = ARRAY_BENCH_REQUESTS;
+        stream.seed = 1;
+        for (int a : cfg.sim.algs)
+        {
+            benchStats s = measure(cfg, ARRAY_BENCH_REQUESTS, [&](long long) {
+                benchSink = (float)policies[a].array(array, stream, pool).simTime;
+            });
+            regressed |= printCase("array", policies[a].name, ARRAY_BENCH_REQUESTS, s, baseline, cfg.threshold, first);
+            first = false;
+        }
+    }
+
+    if (cfg.cases[CASE_ONLINE])
+    {
+        onlineConfig online{cfg.producers, ONLINE_BENCH_REQUESTS, 1, ONLINE_BENCH_CAPACITY, ONLINE_BENCH_DEPTH};
+        for (int a : cfg.sim.algs)
+        {
+            for (int w = 0; w < cfg.warmup; w++)
+                benchSink = (float)policies[a].online(online).simTime;
+            vector<onlineResults> runs;
+            vector<double> nsPerRequest;
+            for (int r = 0; r < cfg.reps; r++)
+            {
+                runs.push_back(policies[a].online(online));
+                nsPerRequest.push_back(runs.back().wallSeconds * 1e9 / ONLINE_BENCH_REQUESTS);
+            }
+            sort(runs.begin(), runs.end(),
+                 [](const onlineResults &x, const onlineResults &y) { return x.wallSeconds < y.wallSeconds; });
+            const onlineResults &m = runs[runs.size() / 2];
+            char extra[512];
+            snprintf(extra, sizeof extra,
+                     ", \"producers\": %d, \"submit_ns\": %.2f, \"submit_per_second\": %.6e, \"dispatch_per_second\": %.6e, "
+                     "\"full_retries\": %lld, \"latency_us\": {\"p50\": %.2f, \"p99\": %.2f, \"p999\": %.2f, \"max\": %.2f}",
+                     cfg.producers, m.submitNs, m.submitRate, m.dispatchRate, m.fullRetries, m.latency.p50 * 1e3,
+                     m.latency.p99 * 1e3, m.latency.p999 * 1e3, m.latency.max * 1e3);
+            regressed |= printCase("online", policies[a].name, ONLINE_BENCH_REQUESTS, summarize(nsPerRequest, 1),
+                                   baseline, cfg.threshold, first, extra);
+            first = false;
+            fflush(stdout);
+        }
+    }
+
+    printf("\n  ]\n}\n");
+    return regressed ? 1 : 0;
+}
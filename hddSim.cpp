@@ -4,10 +4,23 @@ author: Gherkin
 modification history: 
     Gherkin
     November 22nd, 2020
+    Gherkin
+    October 16th, 2026
 procedures:
     [general methods]
     main - Manages the calls for the testing and printing methods.
-    executeAlg - Manages the testing conditions and execution of the scheduling algorithms.
+    parseArgs - Read the command line options into a simConfig struct.
+    parseAlgs - Turn a comma separated list of algorithm names into indexes into the policy registry.
+    executeAlg - Manages the testing conditions and execution of one scheduling policy.
+    shardAlg - Run one shard's chunks of one scheduling policy's sweep.
+    sweepChunks - Run a list of work chunks of one sweep test.
+    reducePoint - Turn the chunks of one sweep test into its results.
+    sweepLimit - Experiments each sweep test may run.
+    executeFused - Run every scheduling algorithm on the same generated requests of each experiment.
+    runExperiment - Generate one experiment's requests and run one scheduling policy on them.
+    executeEvents - Run the discrete-event simulation for every algorithm.
+    executeStream - Run one streaming experiment for every algorithm.
+    executeArray - Run one streamed disk array experiment for every algorithm.
     generateRequests - Randomly generate a collection of simulated I/O requests.
 
     [disk scheduling algorithms]
@@ -15,16 +28,29 @@ procedures:
     sstf - Emulates the performance of a Shortest Service Time First disk scheduling algorithm.
     scan - Emulates the performance of a SCAN disk scheduling algorithm.
     lifo - Emulates the performance of a Last-In-First-Out disk scheduling algorithm.
+    cscan - Emulates the performance of a C-SCAN disk scheduling algorithm.
+    look - Emulates the performance of a LOOK disk scheduling algorithm.
+    clook - Emulates the performance of a C-LOOK disk scheduling algorithm.
+    nstepScan - Emulates the performance of an N-step SCAN disk scheduling algorithm.
+    fscan - Emulates the performance of an FSCAN disk scheduling algorithm.
+    runElevator - Plan and service a batch of requests with one of the elevator algorithms.
+    sstfService - Service a batch of requests in SSTF order from wherever the head is.
+    elevatorService - Service a batch of requests with an elevator algorithm from wherever the head is.
 
     [print management]
     printResults - Apply stylization and print algorithm test results to the console.
+    printPairedResults - Print the paired per-experiment differences against the FIFO baseline.
+    printEventResults - Print the discrete-event simulation results of every algorithm.
+    printStreamResults - Print the streaming results of every algorithm.
+    printArrayResults - Print the disk array results of every algorithm.
+    reportSweep - Print or write the results of a sweep.
+    writeParams - Write the parameters of the run as a record.
+    writeResults - Write one algorithm's sweep results as records.
+    writePairedResults - Write one algorithm's paired differences as records.
+    writeEventResults - Write the discrete-event simulation results as records.
+    writeStreamResults - Write the streaming results as records.
+    writeArrayResults - Write the disk array results as records.
     updateProgressBar - Print a graphical indicator of the current test's progression.
-
-    [helper methods]
-    updateSector - Produce an updated sector value based on the given time value.
-    quicksort - Use a Quicksort algorithm to sort I/O requests by either Sector or Track values.
-    partitionBySector - Quicksort partitioning through comparing Sector values of each I/O request.
-    partitionByTrack - Quicksort partitioning through comparing Track values of each I/O request.
 */
 
 #include <iostream>
@@ -35,12 +61,30 @@ procedures:
 #include <cmath>
 #include <chrono>
 #include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
 #include "ioReq.cpp"
+#include "threadPool.cpp"
+#include "mpscQueue.cpp"
+#include "reqBatch.cpp"
+#include "latencyHist.cpp"
+#include "runningStats.cpp"
+#include "counterRng.cpp"
+#include "resultSink.cpp"
+#include "selfProfile.cpp"
 
 using namespace std;
 
 /* Define HDD constants */
 #define EXPERIMENTS 1000
+#define CHUNK_SIZE 32           // Experiments per work chunk; fixed so results never depend on thread count
+#define ADAPT_ROUND 8           // Chunks run between convergence checks of the adaptive sweep
 #define AVG_SEEK_TIME 0.024875  // Time needed to move the head between tracks in milliseconds
 #define AVG_ROT_LATENCY 2.5     // Avg Rotational Latency; 2.5 ms for 180 degrees
 #define TRANSFER_RATE 6         // 6 GB/s
@@ -51,6 +95,11 @@ using namespace std;
 #define MS_PER_SECT 0.000556    // Millisecond per sector
 #define TRACKS 201
 #define SECTORS 360
+/* The constants above describe the built-in drive; --drive loads another one (driveModel.cpp) */
+
+/* Scheduling algorithms are policies registered in schedPolicy.cpp. --algs picks which ones run and
+   in what order; the first one picked is the baseline that the fused mode pairs the others against. */
+#define DEFAULT_ALGS 4          // FIFO, SSTF, SCAN and LIFO run when --algs is not given
 
 /* Struct holding the info (results) for one experiment */
 struct hddSim
@@ -59,10 +108,17 @@ struct hddSim
     int totalRequests;          // Total number of requests
     float totalTime;            // Total time duration of simulation
     float totalAvgAccessTime;   // Total average access time
+    float fifoSeek;             // FIFO seek time of the requests, the --control variate (0 without it)
+    int cacheHits;              // Requests served from the drive cache (0 without --cache)
+    float seekTime;             // Time spent seeking, head moves included
+    float rotationTime;         // Time spent waiting for sectors to come under the head
+    float transferTime;         // Time spent transferring blocks, from the platter or the cache
+    int trackSwitches;          // Seeks that moved the head to another track
+    int missedRotations;        // Requests whose sector had just passed, costing most of a rotation
+    long long seekTracks;       // Tracks crossed, counted exactly (avgSeekLength sums them in float)
 
     /* Unused vars */
     //float avgRequestT;        // Average Request Time
-    //float avgRotDelay;        // Average Rotational Delay
     //float avgAccessT;         // Average Access Time
     //int totalBytes;           // Total number of bytes transferred
 };
@@ -73,730 +129,1969 @@ struct results
     float totalAvgAccessTime;   // Total Average Access Time
     float avgReqTime;           // Average Request Time
     int totalReq;               // Total number of requests
+    latencySummary latency;     // Per-request completion latency percentiles
+    int experiments;            // Experiments the averages were taken over
+    float ciHalfWidth;          // 95 % confidence interval half-width of avgReqTime
+    float cacheHitRate;         // Share of requests served from the drive cache (0 without --cache)
+    float seekTime;             // Mean time per experiment spent seeking
+    float rotationTime;         // Mean time per experiment spent waiting for sectors
+    float transferTime;         // Mean time per experiment spent transferring
+    float trackSwitches;        // Mean seeks per experiment that changed track
+    float missedRotations;      // Mean requests per experiment whose sector had just passed
+};
+
+/* Struct holding one algorithm's paired difference to the baseline for a batch of tests */
+struct pairedDiff
+{
+    float meanDiff;             // Mean per-experiment difference in total time (alg - baseline)
+    float stdErr;               // Standard error of the mean difference
+};
+
+/* Struct holding every algorithm's results from a fused run, indexed like the policy registry */
+struct fusedResults
+{
+    vector<vector<results>> alg;        // Results per algorithm, same layout as executeAlg
+    vector<vector<pairedDiff>> diff;    // Paired differences against the baseline; empty for the baseline
+};
+
+/* Struct holding one work chunk's share of a sweep test */
+struct chunkPartial
+{
+    results sums;               // totalAvgAccessTime, avgReqTime, totalReq and the time components summed over the chunk
+    runningCov stats;           // Replicate means of the chunk (see executeAlg)
+    long long cacheHits;        // Requests of the chunk served from the drive cache
+    long long trackSwitches;    // Track switches of the chunk's experiments
+    long long missedRotations;  // Requests of the chunk whose sector had just passed
+    bool done;                  // The chunk has been run
+};
+
+/* Struct holding everything one sweep test's results are computed from. Shards of a sweep each run
+   some of the chunks (see sweepShard.cpp); laying their chunks side by side gives the whole test. */
+struct pointPartial
+{
+    int io;                     // Requests per experiment
+    vector<chunkPartial> chunks;        // Every chunk of the test, in index order
+    latencyHist latency;        // Completion latencies of the chunks that have run
 };
 
+#include "driveModel.cpp"
+#include "driveCache.cpp"
+#include "reqSort.cpp"
+#include "reqMerge.cpp"
+#include "serviceKernel.cpp"
+#include "sampling.cpp"
+#include "sstfIndex.cpp"
+#include "elevator.cpp"
+#include "traceReplay.cpp"
+
 /* Define methods */
-vector<results> executeAlg(char alg);
-hddSim fifo(vector<ioReq> req);
-hddSim sstf(vector<ioReq> req);
-hddSim scan(vector<ioReq> req);
-hddSim lifo(vector<ioReq> req);
-vector<ioReq> generateRequests(int n, unsigned seed);
+hddSim fifo(reqSpan req);
+hddSim sstf(reqSpan req);
+hddSim scan(reqSpan req);
+hddSim lifo(reqSpan req);
+hddSim cscan(reqSpan in);
+hddSim look(reqSpan in);
+hddSim clook(reqSpan in);
+hddSim nstepScan(reqSpan in);
+hddSim fscan(reqSpan in);
+template <class Policy>
+hddSim runElevator(reqSpan in);
+void sstfService(headState &head, reqSpan in, hddSim &sim);
+template <class Policy>
+void elevatorService(headState &head, reqSpan in, hddSim &sim);
+void generateRequests(int n, experimentKey key, reqBatch &requests);
+
+#include "laneEval.cpp"
+#include "eventSim.cpp"
+#include "streamSim.cpp"
+#include "arraySim.cpp"
+#include "onlineSched.cpp"
+
+/* Struct holding the command line options */
+struct simConfig
+{
+    int threads;                // Number of threads used to run experiments
+    bool fused;                 // Run all algorithms on a shared request set per experiment
+    bool lanes;                 // Evaluate order-fixed algorithms several experiments at a time
+    bool events;                // Run the discrete-event simulation instead of the sweep
+    vector<int> algs;           // Indexes into the policy registry of the algorithms to run, in order
+    arrivalConfig arrivals;     // Arrival settings for the discrete-event simulation
+    bool streaming;             // Run one long streamed experiment per algorithm instead of the sweep
+    streamConfig stream;        // Settings for the streaming mode
+    arrayConfig array;          // Streaming: split the stream over a disk array (array.level set)
+    double ciTarget;            // Adaptive sweep: relative CI half-width to stop at; 0 runs EXPERIMENTS
+    int minExperiments;         // Adaptive sweep: experiments run before convergence is first checked
+    int maxExperiments;         // Adaptive sweep: experiments after which a point stops regardless
+    char format;                // Results output: 't' tables, or 'c' CSV, 'j' JSON Lines, 'b' binary (resultSink)
+    const char *outputPath;     // File the results are written to, or null for stdout
+    const char *drivePath;      // Drive config in use, or null for the built-in drive
+    const char *tracePath;      // Trace being replayed or streamed, or null
+    unsigned seed;              // Base randomization seed (--seed; from the clock by default)
+    int shardIndex;             // Sharded sweep: the shard this process runs (see sweepShard.cpp)
+    int shardCount;             // Sharded sweep: number of shards; 0 runs the whole sweep
+    int procs;                  // Run the sweep as this many local shard processes and merge them
+    vector<const char *> mergePaths;    // Shard files to merge into the results of one sweep
+};
+
+/* Define driver and print methods */
+simConfig parseArgs(int argc, char *argv[]);
+vector<int> parseAlgs(const char *list);
+template <class Policy>
+vector<results> executeAlg(const simConfig &cfg, threadPool &pool);
+template <class Policy>
+vector<pointPartial> shardAlg(const simConfig &cfg, threadPool &pool);
+template <class Policy>
+void sweepChunks(const simConfig &cfg, threadPool &pool, pointPartial &point, const vector<int> &todo,
+                 vector<latencyHist> &workerLatency);
+results reducePoint(const pointPartial &point, int chunks);
+int sweepLimit(const simConfig &cfg);
+template <class Policy>
+hddSim runExperiment(int n, experimentKey key);
+fusedResults executeFused(const simConfig &cfg, threadPool &pool);
+vector<eventResults> executeEvents(const simConfig &cfg, threadPool &pool);
+vector<streamResults> executeStream(const simConfig &cfg, threadPool &pool);
+vector<arrayResults> executeArray(const simConfig &cfg, threadPool &pool);
 void printResults(vector<results> res);
+void printPairedResults(const vector<pairedDiff> &diff);
+void printEventResults(const simConfig &cfg, const vector<eventResults> &res);
+void printStreamResults(const simConfig &cfg, const vector<streamResults> &res);
+void printArrayResults(const simConfig &cfg, const vector<arrayResults> &res);
+void reportSweep(const simConfig &cfg, const vector<vector<results>> &algResults, resultSink &sink);
+void writeParams(resultSink &sink, const simConfig &cfg, const char *mode);
+void writeResults(resultSink &sink, const char *alg, const vector<results> &res);
+void writePairedResults(resultSink &sink, const char *alg, const char *baseline, const vector<pairedDiff> &diff);
+void writeEventResults(resultSink &sink, const simConfig &cfg, const vector<eventResults> &res);
+void writeStreamResults(resultSink &sink, const simConfig &cfg, const vector<streamResults> &res);
+void writeArrayResults(resultSink &sink, const simConfig &cfg, const vector<arrayResults> &res);
 void updateProgressBar(int p, int total, char alg);
-int partitionBySector(vector<ioReq> &values, int left, int right);
-int partitionByTrack(vector<ioReq> &req, int left, int right);
-void quicksort(vector<ioReq> &values, int left, int right, string comparison);
 
+bool showProgress = true;       // Draw progress bars during sweeps; off when benchmarking
+bool showBreakdown = false;     // Add the time components to the sweep tables (--breakdown)
+#define PROGRESS_INTERVAL_MS 100 // Shortest time between two redraws of the progress bar
+
+#include "schedPolicy.cpp"
+#include "sweepShard.cpp"
+
+/* hddBench.cpp includes this file for its drivers and defines HDDSIM_NO_MAIN to supply its own main */
+#ifndef HDDSIM_NO_MAIN
 
 /*
-    int main()
+    int main(argc, argv)
     author: Gherkin
     date: Nov 22, 2020
     description: Manages the calls for the testing and printing methods.
+    parameters:
+        argc  I/P  int     Number of command line arguments
+        argv  I/P  char**  Command line arguments (see parseArgs)
 */
-int main()
+int main(int argc, char *argv[])
 {
-    vector<results> fifoResults = executeAlg('a');
-    vector<results> sstfResults = executeAlg('b');
-    vector<results> scanResults = executeAlg('c');
-    vector<results> lifoResults = executeAlg('d');
+    simConfig cfg = parseArgs(argc, argv);
+    const vector<schedEntry> &policies = schedRegistry();
+
+    // results go to stdout (or --output) as tables or through a sink; progress goes to stderr
+    const bool binary = cfg.format == 'b' || cfg.shardCount > 0;
+    if (cfg.outputPath != nullptr && freopen(cfg.outputPath, binary ? "wb" : "w", stdout) == nullptr)
+    {
+        cerr << "cannot write results: " << cfg.outputPath << "\n";
+        return 1;
+    }
+
+    // merging and local shard processes come before the pool so no thread is running across fork
+    if (!cfg.mergePaths.empty())
+        return mergeShards(cfg) ? 0 : 1;
+    cerr << "Seed " << cfg.seed << "\n";
+#if !defined(_WIN32)
+    if (cfg.procs > 1)
+        return runShardProcs(cfg) ? 0 : 1;
+#endif
+
+    threadPool pool(cfg.threads);
+    sortPool = &pool;   // sorts made on this thread outside the pool's runs may use it
+    if (cfg.shardCount > 0)
+        return runShard(cfg, pool, stdout) ? 0 : 1;
+
+    const bool tables = cfg.format == 't';
+    resultSink sink(cfg.format, stdout);
 
-    cout << "FIFO Results:\n";
-    printResults(fifoResults);
-    cout << "SSTF Results:\n";
-    printResults(sstfResults);
-    cout << "SCAN Results:\n";
-    printResults(scanResults);
-    cout << "LIFO Results:\n";
-    printResults(lifoResults);
+    if (cfg.array.level != 0)
+    {
+        vector<arrayResults> res = executeArray(cfg, pool);
+        if (tables)
+            printArrayResults(cfg, res);
+        else
+        {
+            writeParams(sink, cfg, "array");
+            writeArrayResults(sink, cfg, res);
+        }
+        reportProfile(sink, tables);
+        return 0;
+    }
+
+    if (cfg.streaming)
+    {
+        vector<streamResults> res = executeStream(cfg, pool);
+        if (tables)
+            printStreamResults(cfg, res);
+        else
+        {
+            writeParams(sink, cfg, "stream");
+            writeStreamResults(sink, cfg, res);
+        }
+        reportProfile(sink, tables);
+        return 0;
+    }
+
+    if (cfg.events)
+    {
+        vector<eventResults> res = executeEvents(cfg, pool);
+        if (tables)
+            printEventResults(cfg, res);
+        else
+        {
+            writeParams(sink, cfg, "events");
+            writeEventResults(sink, cfg, res);
+        }
+        return 0;
+    }
+
+    if (cfg.fused)
+    {
+        fusedResults res = executeFused(cfg, pool);
+        const char *baseline = policies[cfg.algs[0]].name;
+        if (!tables)
+            writeParams(sink, cfg, "fused");
+        for (int a : cfg.algs)
+        {
+            if (!tables)
+            {
+                writeResults(sink, policies[a].name, res.alg[a]);
+                continue;
+            }
+            cout << policies[a].name << " Results:\n";
+            printResults(res.alg[a]);
+        }
+        for (size_t k = 1; k < cfg.algs.size(); k++)
+        {
+            if (!tables)
+            {
+                writePairedResults(sink, policies[cfg.algs[k]].name, baseline, res.diff[cfg.algs[k]]);
+                continue;
+            }
+            cout << policies[cfg.algs[k]].name << " - " << baseline << " Paired Differences:\n";
+            printPairedResults(res.diff[cfg.algs[k]]);
+        }
+        reportProfile(sink, tables);
+        return 0;
+    }
+
+    vector<vector<results>> algResults(policies.size());
+    for (int a : cfg.algs)
+        algResults[a] = policies[a].sweep(cfg, pool);
+    reportSweep(cfg, algResults, sink);
 
     return 0;
 }
+#endif
 
 /*
-    vector<results> executeAlg(char alg)
+    simConfig parseArgs(argc, argv)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Manages the testing conditions and execution of the scheduling algorithms.
+    date: Oct 16, 2026
+    description: Read the command line options into a simConfig struct. Supported options:
+        -t, --threads N   number of threads (default: one per hardware thread; 1 runs serially)
+        -a, --algs LIST   comma separated algorithm names to run, or "all" (default FIFO,SSTF,SCAN,LIFO)
+        --nstep N         requests per sub-queue for N-SCAN (default 10)
+        -f, --fused       run every algorithm on the same requests and report paired differences
+        -s, --scalar      evaluate every experiment on its own instead of in SIMD lane groups
+        -e, --events      run the discrete-event simulation with requests arriving over time
+        --ci REL          stop each test once the 95 % confidence interval of its average request
+                          time is within REL of the mean (e.g. 0.01), instead of after 1000 experiments
+        --min-exp N       adaptive sweep: experiments before convergence is first checked (default 64)
+        --max-exp N       adaptive sweep: experiments after which a test stops regardless (default 100000)
+        --sampling MODE   sweep request sets: uniform (default), antithetic, stratified or sobol
+                          (see sampleRequests)
+        --control         estimate the average request time with the FIFO seek time as a control
+                          variate
+        --breakdown       add the seek, rotation and transfer time and the track switch and missed
+                          rotation counts to the sweep tables (the records always carry them)
+        --format F        results as tables (default), csv, jsonl or binary (see resultSink)
+        -o, --output FILE write the results to FILE instead of stdout
+        --seed S          randomization seed; the same seed repeats a run exactly (default: random,
+                          and printed to stderr)
+        --shard K/N       run shard K (0 to N-1) of the sweep and write its partial results, to be
+                          merged with the other shards' (see sweepShard.cpp); needs --seed
+        --merge FILE...   merge shard files into the results of the whole sweep
+        --procs P         run the sweep as P local shard processes and merge their results (not on Windows)
+        --drive FILE      simulate the drive described in FILE (see loadDriveModel) instead of the
+                          built-in one
+        --cache N         give the drive a segmented LRU cache of N track read-ahead segments (see
+                          driveCache); not with -e
+        --rate R          event simulation: mean arrival rate in requests per second (default 400)
+        --horizon S       event simulation: seconds of arrivals to simulate (default 3600)
+        --bursty ON OFF   event simulation: on/off bursts with mean period lengths in ms
+        --stream N        run one experiment of N requests per algorithm, fed to the scheduler in
+                          windows so memory does not grow with N (N may be 0 with --trace)
+        --window W        streaming: requests admitted to the scheduler at a time (default 4096)
+        --array LEVEL     streaming: split the stream over a raid0, raid1 or raid10 disk array of
+                          identical drives, each running the algorithm (see arrayRun)
+        --disks N         array: number of drives (default 4)
+        --stripe K        array: blocks per stripe unit for raid0 and raid10 (default 16)
+        --writes F        array: fraction of requests that are writes, sent to every mirror (default 0)
+        --coalesce K      streaming: merge each window's contiguous and repeated requests on a track
+                          into requests of up to K blocks before scheduling (see reqMerge.cpp)
+        --trace FILE      event simulation: replay a blkparse or MSR CSV block trace (implies -e);
+                          with --stream, the trace's requests are streamed instead. Each record is
+                          replayed as a one-block read at its offset: its size and read/write
+                          direction are ignored
+        --trace-format F  trace format, blkparse or msr (default: detected from the first line)
+        --trace-span B    size of the traced device (K/M/G/T suffix) to scale onto the drive;
+                          by default block numbers wrap around the drive
     parameters:
-        alg         I/P  char             character indicating which alg to execute
-        executeAlg  O/P  vector<results>  Vector containing the results for all tests
+        argc       I/P  int        Number of command line arguments
+        argv       I/P  char**     Command line arguments
+        parseArgs  O/P  simConfig  Parsed options
 */
-vector<results> executeAlg(char alg)
+simConfig parseArgs(int argc, char *argv[])
 {
-    // start clock
-    typedef std::chrono::high_resolution_clock clock;
-    clock::time_point start_point = clock::now();
-
-    vector<results> algRes;
+    simConfig cfg;
+    cfg.threads = defaultThreads();
+    cfg.fused = false;
+    cfg.lanes = true;
+    cfg.events = false;
+    cfg.arrivals.kind = 'p';
+    cfg.arrivals.rate = 400;
+    cfg.arrivals.burstOn = 0;
+    cfg.arrivals.burstOff = 0;
+    cfg.arrivals.horizon = 3600 * 1000.0;
+    cfg.seed = std::random_device()();
+    cfg.arrivals.seed = cfg.seed;
+    cfg.arrivals.trace = nullptr;
+    cfg.arrivals.traceFormat = 0;
+    cfg.arrivals.traceSpan = 0;
+    cfg.streaming = false;
+    cfg.stream.requests = 0;
+    cfg.stream.window = 4096;
+    cfg.stream.seed = cfg.arrivals.seed;
+    cfg.stream.trace = nullptr;
+    cfg.array.level = 0;
+    cfg.array.disks = 4;
+    cfg.array.stripe = 16;
+    cfg.array.writeFraction = 0;
+    cfg.ciTarget = 0;
+    cfg.minExperiments = 64;
+    cfg.maxExperiments = 100000;
+    cfg.format = 't';
+    cfg.outputPath = nullptr;
+    cfg.drivePath = nullptr;
+    cfg.tracePath = nullptr;
+    cfg.shardIndex = 0;
+    cfg.shardCount = 0;
+    cfg.procs = 0;
+    bool horizonSet = false;
+    bool seedSet = false;
+    bool merging = false;
+    for (int a = 0; a < DEFAULT_ALGS; a++)
+        cfg.algs.push_back(a);
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--threads") == 0) && i + 1 < argc)
+            cfg.threads = max(1, atoi(argv[++i]));
+        else if ((strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--algs") == 0) && i + 1 < argc)
+            cfg.algs = parseAlgs(argv[++i]);
+        else if (strcmp(argv[i], "--nstep") == 0 && i + 1 < argc)
+            nstepSize = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--fused") == 0)
+            cfg.fused = true;
+        else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--scalar") == 0)
+            cfg.lanes = false;
+        else if (strcmp(argv[i], "-e") == 0 || strcmp(argv[i], "--events") == 0)
+            cfg.events = true;
+        else if (strcmp(argv[i], "--ci") == 0 && i + 1 < argc)
+            cfg.ciTarget = max(0.0, atof(argv[++i]));
+        else if (strcmp(argv[i], "--min-exp") == 0 && i + 1 < argc)
+            cfg.minExperiments = max(2, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--max-exp") == 0 && i + 1 < argc)
+            cfg.maxExperiments = max(2, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--sampling") == 0 && i + 1 < argc)
+        {
+            i++;
+            const char *modes[4] = {"uniform", "antithetic", "stratified", "sobol"};
+            const char ids[4] = {'u', 'a', 's', 'q'};
+            sampling.mode = 0;
+            for (int m = 0; m < 4; m++)
+                if (strcasecmp(argv[i], modes[m]) == 0)
+                    sampling.mode = ids[m];
+            if (sampling.mode == 0)
+            {
+                cerr << "unknown sampling mode: " << argv[i] << "\n";
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--control") == 0)
+            sampling.control = true;
+        else if (strcmp(argv[i], "--breakdown") == 0)
+            showBreakdown = true;
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc)
+        {
+            i++;
+            const char *formats[4] = {"tables", "csv", "jsonl", "binary"};
+            const char ids[4] = {'t', 'c', 'j', 'b'};
+            cfg.format = 0;
+            for (int f = 0; f < 4; f++)
+                if (strcasecmp(argv[i], formats[f]) == 0)
+                    cfg.format = ids[f];
+            if (cfg.format == 0)
+            {
+                cerr << "unknown results format: " << argv[i] << "\n";
+                exit(1);
+            }
+        }
+        else if ((strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) && i + 1 < argc)
+            cfg.outputPath = argv[++i];
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            cfg.seed = (unsigned)strtoul(argv[++i], nullptr, 0);
+            cfg.arrivals.seed = cfg.seed;
+            cfg.stream.seed = cfg.seed;
+            seedSet = true;
+        }
+        else if (strcmp(argv[i], "--shard") == 0 && i + 1 < argc)
+        {
+            i++;
+            if (sscanf(argv[i], "%d/%d", &cfg.shardIndex, &cfg.shardCount) != 2 || cfg.shardCount < 1 ||
+                cfg.shardIndex < 0 || cfg.shardIndex >= cfg.shardCount)
+            {
+                cerr << "--shard wants K/N with 0 <= K < N: " << argv[i] << "\n";
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--merge") == 0)
+            merging = true;
+        else if (merging && argv[i][0] != '-')
+            cfg.mergePaths.push_back(argv[i]);
+        else if (strcmp(argv[i], "--procs") == 0 && i + 1 < argc)
+            cfg.procs = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--drive") == 0 && i + 1 < argc)
+        {
+            cfg.drivePath = argv[++i];
+            if (!loadDriveModel(cfg.drivePath, drive))
+                exit(1);
+        }
+        else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc)
+            cacheSettings.segments = max(0, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc)
+            cfg.arrivals.rate = atof(argv[++i]);
+        else if (strcmp(argv[i], "--horizon") == 0 && i + 1 < argc)
+        {
+            cfg.arrivals.horizon = atof(argv[++i]) * 1000;
+            horizonSet = true;
+        }
+        else if (strcmp(argv[i], "--stream") == 0 && i + 1 < argc)
+        {
+            cfg.streaming = true;
+            cfg.stream.requests = (long long)atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc)
+            cfg.stream.window = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--coalesce") == 0 && i + 1 < argc)
+            mergeSettings.maxBlocks = max(0, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--array") == 0 && i + 1 < argc)
+        {
+            i++;
+            const char *levels[3] = {"raid0", "raid1", "raid10"};
+            const char ids[3] = {RAID_0, RAID_1, RAID_10};
+            cfg.array.level = 0;
+            for (int l = 0; l < 3; l++)
+                if (strcasecmp(argv[i], levels[l]) == 0)
+                    cfg.array.level = ids[l];
+            if (cfg.array.level == 0)
+            {
+                cerr << "unknown array level: " << argv[i] << "\n";
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--disks") == 0 && i + 1 < argc)
+            cfg.array.disks = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--stripe") == 0 && i + 1 < argc)
+            cfg.array.stripe = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--writes") == 0 && i + 1 < argc)
+            cfg.array.writeFraction = min(1.0, max(0.0, atof(argv[++i])));
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+            cfg.tracePath = argv[++i];
+        else if (strcmp(argv[i], "--trace-format") == 0 && i + 1 < argc)
+        {
+            i++;
+            cfg.arrivals.traceFormat = strcasecmp(argv[i], "msr") == 0 ? 'm' : (strcasecmp(argv[i], "blkparse") == 0 ? 'b' : '?');
+            if (cfg.arrivals.traceFormat == '?')
+            {
+                cerr << "unknown trace format: " << argv[i] << "\n";
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--trace-span") == 0 && i + 1 < argc)
+            cfg.arrivals.traceSpan = parseBytes(argv[++i]);
+        else if (strcmp(argv[i], "--bursty") == 0 && i + 2 < argc)
+        {
+            cfg.arrivals.kind = 'b';
+            cfg.arrivals.burstOn = atof(argv[++i]);
+            cfg.arrivals.burstOff = atof(argv[++i]);
+        }
+        else
+        {
+            cerr << "usage: " << argv[0] << " [-t threads] [-a algs] [--nstep N] [--drive FILE] [-f] [-s] [--ci REL [--min-exp N] [--max-exp N]]"
+                 << " [--sampling uniform|antithetic|stratified|sobol] [--control] [--breakdown]"
+                 << " [--format tables|csv|jsonl|binary] [-o FILE] [--seed S] [--shard K/N | --procs P | --merge FILE...] [--cache N] [-e [--rate R] [--horizon S] [--bursty ON OFF]]"
+                 << " [--stream N [--window W] [--coalesce K] [--array raid0|raid1|raid10 [--disks N] [--stripe K] [--writes F]]] [--trace FILE [--trace-format blkparse|msr] [--trace-span BYTES]]\n";
+            exit(1);
+        }
+    }
 
-    // testing range of 50 to 150 I/O requests, incrementing in steps of 10
-    for (int io = 50; io <= 150; io += 10)
+    // a trace replaces the generated arrivals (or, when streaming, the generated requests) and plays
+    // to its end unless a horizon or request count was given
+    if (cfg.tracePath != nullptr)
     {
-        results batchRes; // set up collection results struct
-        batchRes.avgReqTime = 0;
-        batchRes.totalReq = 0;
+        static traceFile trace(cfg.tracePath);
+        if (!trace.ok())
+        {
+            cerr << "cannot map trace: " << cfg.tracePath << "\n";
+            exit(1);
+        }
+        if (cfg.arrivals.traceFormat == 0)
+            cfg.arrivals.traceFormat = detectTraceFormat(trace);
+        cfg.arrivals.kind = 'r';
+        cfg.arrivals.trace = &trace;
+        cfg.events = !cfg.streaming;
+        if (!horizonSet)
+            cfg.arrivals.horizon = HUGE_VAL;
+        cfg.stream.trace = &trace;
+        cfg.stream.traceFormat = cfg.arrivals.traceFormat;
+        cfg.stream.traceSpan = cfg.arrivals.traceSpan;
+    }
+    else if (cfg.streaming && cfg.stream.requests <= 0)
+    {
+        cerr << "--stream needs a request count when no trace is given\n";
+        exit(1);
+    }
+    cfg.maxExperiments = max(cfg.maxExperiments, cfg.minExperiments);
 
-        // conduct 1000 trials and report the averaged results
-        for (int e = 0; e < EXPERIMENTS; e++)
+    // the array splits a generated logical stream; mirrors come in pairs for RAID-10
+    if (cfg.array.level != 0)
+    {
+        if (!cfg.streaming || cfg.tracePath != nullptr)
         {
-            // create randomization seed using the duration from the clock's staring point
-            clock::duration d = clock::now() - start_point;
-            unsigned seed = d.count();
+            cerr << "--array needs --stream N and generated requests\n";
+            exit(1);
+        }
+        if ((cfg.array.level == RAID_1 && cfg.array.disks < 2) ||
+            (cfg.array.level == RAID_10 && (cfg.array.disks < 4 || cfg.array.disks % 2 != 0)))
+        {
+            cerr << "--array raid1 needs at least 2 disks and raid10 an even number of at least 4\n";
+            exit(1);
+        }
+        if ((uint64_t)cfg.array.stripe > drive.blocks)
+        {
+            cerr << "--stripe is larger than the drive\n";
+            exit(1);
+        }
+    }
 
-            vector<ioReq> requests = generateRequests(io, seed); // generate vector of I/O requests
-            hddSim s;
+    // the fused mode pairs experiments across algorithms and keeps to independent uniform ones
+    if (cfg.fused && (sampling.mode != 'u' || sampling.control))
+    {
+        cerr << "--sampling and --control apply to the sweep, not the fused mode\n";
+        exit(1);
+    }
 
-            switch (alg)
-            {
-            case 'a':
-                s = fifo(requests);
-                break;
-            case 'b':
-                s = sstf(requests);
-                break;
-            case 'c':
-                s = scan(requests);
-                break;
-            case 'd':
-                s = lifo(requests);
-                break;
-            }
+    // the event simulation services one request at a time outside serviceSequence
+    if (cfg.events && cacheSettings.segments > 0)
+    {
+        cerr << "--cache applies to the sweep, fused, stream and array modes, not -e\n";
+        exit(1);
+    }
 
-            batchRes.totalAvgAccessTime += s.totalAvgAccessTime;
-            batchRes.avgReqTime += s.totalTime;
-            batchRes.totalReq += io;
-        }
+    // merging needs windows of requests to merge; a sweep experiment's few uniform ones hardly touch
+    if (mergeSettings.maxBlocks > 0 && !cfg.streaming)
+    {
+        cerr << "--coalesce applies to the stream and array modes\n";
+        exit(1);
+    }
 
-        // convert values into averages
-        batchRes.totalAvgAccessTime /= EXPERIMENTS;
-        batchRes.avgReqTime /= EXPERIMENTS;
-        batchRes.totalReq /= EXPERIMENTS;
+    // shards split the fixed-length sweep; an adaptive test needs all of its chunks to decide when
+    // to stop, and the shards of one sweep must all draw from the same seed
+    bool sharded = cfg.shardCount > 0 || cfg.procs > 1 || merging;
+    if (sharded && (cfg.fused || cfg.events || cfg.streaming || cfg.ciTarget > 0))
+    {
+        cerr << "--shard, --procs and --merge apply to the fixed-length sweep only\n";
+        exit(1);
+    }
+#if defined(_WIN32)
+    // the local launcher forks its shards; run --shard processes and --merge them by hand instead
+    if (cfg.procs > 1)
+    {
+        cerr << "--procs is not available on Windows; run each shard with --shard K/N and combine them with --merge\n";
+        exit(1);
+    }
+#endif
+    if ((cfg.shardCount > 0) + (cfg.procs > 1) + merging > 1)
+    {
+        cerr << "--shard, --procs and --merge are alternatives\n";
+        exit(1);
+    }
+    if (cfg.shardCount > 0 && !seedSet)
+    {
+        cerr << "--shard needs --seed so every shard draws from the same seed\n";
+        exit(1);
+    }
+    if (merging && cfg.mergePaths.empty())
+    {
+        cerr << "--merge needs at least one shard file\n";
+        exit(1);
+    }
 
-        algRes.push_back(batchRes); // add batch results to total results vector
-        updateProgressBar(io - 50, 100, alg);
+    // the arrival gaps are exponential, which needs a positive rate and on period
+    if (!(cfg.arrivals.rate > 0))
+    {
+        cerr << "--rate must be above 0 requests per second\n";
+        exit(1);
     }
-    return algRes;
+    if (!(cfg.arrivals.horizon > 0))
+    {
+        cerr << "--horizon must be above 0 seconds\n";
+        exit(1);
+    }
+    if (cfg.arrivals.kind == 'b' && !(cfg.arrivals.burstOn > 0 && cfg.arrivals.burstOff >= 0))
+    {
+        cerr << "--bursty needs an on period above 0 ms and an off period of at least 0 ms\n";
+        exit(1);
+    }
+    return cfg;
 }
 
 /*
-    int updateSector(float currentTime)
+    vector<int> parseAlgs(list)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Produce an updated sector value based on the given time value
+    date: Oct 16, 2026
+    description: Turn a comma separated list of algorithm names (case insensitive) into indexes into
+        the policy registry. "all" selects every registered policy. Exits with a message on an
+        unknown name.
     parameters:
-        currentTime   I/P  float  Time value used to calculate sector position
-        updateSector  O/P  int    Updated value of sector position
+        list       I/P  char*        Comma separated algorithm names
+        parseAlgs  O/P  vector<int>  Indexes into schedRegistry, in the order given
 */
-int updateSector(float currentTime)
+vector<int> parseAlgs(const char *list)
 {
-    int s = currentTime * (RPMS / 360);
-    s -= (360 * (s / 360));
-    s -= 1;
-    return s;
+    vector<int> algs;
+    string names = list;
+    size_t pos = 0;
+    while (pos <= names.size())
+    {
+        size_t comma = names.find(',', pos);
+        if (comma == string::npos)
+            comma = names.size();
+        string name = names.substr(pos, comma - pos);
+        pos = comma + 1;
+
+        if (strcasecmp(name.c_str(), "all") == 0)
+        {
+            for (int a = 0; a < (int)schedRegistry().size(); a++)
+                algs.push_back(a);
+            continue;
+        }
+
+        int found = findPolicy(name.c_str());
+        if (found < 0)
+        {
+            cerr << "unknown algorithm: " << name << "\n";
+            exit(1);
+        }
+        algs.push_back(found);
+    }
+    return algs;
 }
 
 /*
-    int updateSector(int sector, int duration)
+    vector<results> executeAlg<Policy>(cfg, pool)
     author: Gherkin
     date: Nov 22, 2020
-    description: Increased the current sector value based on the given time value
+    description: Manages the testing conditions and execution of one scheduling policy.
+        The experiments of each test are split into chunks of CHUNK_SIZE that are run across the
+        thread pool (sweepChunks). Each chunk sums into its own results struct and the chunks are
+        merged in index order (reducePoint), so the output is bit-identical for any number of
+        threads, and for any split of the chunks across shard processes (shardAlg). Instantiated
+        once per policy, so the policy is called directly.
+        With cfg.ciTarget set, a test runs cfg.minExperiments and then ADAPT_ROUND chunks at a time
+        until the confidence interval of its average request time is narrow enough or
+        cfg.maxExperiments have run. Convergence is only checked between rounds, on chunks merged in
+        index order, so where a test stops does not depend on the thread count either.
     parameters:
-        sector        I/P  int  Current sector position value
-        duration      I/P  int  Duration of time
-        updateSector  O/P  int  Increased value of sector position
+        Policy      I/P  class            Scheduling policy (see schedPolicy.cpp)
+        cfg         I/P  simConfig        Command line options
+        pool        I/P  threadPool       Threads used to run the experiments
+        executeAlg  O/P  vector<results>  Vector containing the results for all tests
 */
-int updateSector(int sector, int duration)
+template <class Policy>
+vector<results> executeAlg(const simConfig &cfg, threadPool &pool)
 {
-    int sec = sector;
-    for (int i = 0; i < duration; i++)
+    const bool adaptive = cfg.ciTarget > 0;
+    const int chunks = (sweepLimit(cfg) + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int firstRound = adaptive ? (cfg.minExperiments + CHUNK_SIZE - 1) / CHUNK_SIZE : 0;
+
+    vector<results> algRes;
+    pointPartial point;
+    vector<int> todo;
+    vector<latencyHist> workerLatency(pool.size());
+
+    // testing range of 50 to 150 I/O requests, incrementing in steps of 10
+    for (int io = 50; io <= 150; io += 10)
     {
-        sec++;
-        if (sec == 360)
-            sec = 0;
+        point.io = io;
+        point.chunks.assign(chunks, chunkPartial());
+        point.latency.clear();
+        runningCov stats;
+
+        // conduct 1000 trials (or rounds of trials until the test converges), one chunk per task
+        int done = 0;
+        int next = adaptive ? min(chunks, firstRound) : chunks;
+        while (done < next)
+        {
+            todo.clear();
+            for (int c = done; c < next; c++)
+                todo.push_back(c);
+            sweepChunks<Policy>(cfg, pool, point, todo, workerLatency);
+
+            for (int c = done; c < next; c++)
+                stats.merge(point.chunks[c].stats);
+            done = next;
+
+            double halfWidth = sampling.control ? stats.controlledHalfWidth() : stats.halfWidth();
+            if (adaptive && halfWidth > cfg.ciTarget * fabs(stats.meanY))
+                next = min(chunks, done + ADAPT_ROUND);
+        }
+
+        algRes.push_back(reducePoint(point, done)); // add batch results to total results vector
+        updateProgressBar(io - 50, 100, Policy::id);
     }
-    return sec;
+    return algRes;
 }
 
 /*
-    hddSim fifo(vector<ioReq> req)
+    vector<pointPartial> shardAlg<Policy>(cfg, pool)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Emulates the performance of a First-In-First-Out disk scheduling algorithm.
+    date: Oct 16, 2026
+    description: Run the chunks of one scheduling policy's sweep that belong to shard
+        cfg.shardIndex of cfg.shardCount (see shardOwns), leaving the others not done. The partials
+        of all the shards together hold every chunk exactly once.
     parameters:
-        req   I/P  vector<ioReq>  Vector of simulated I/O requests
-        fifo  O/P  hddSim         Struct containing simulation statistics
+        Policy    I/P  class                 Scheduling policy (see schedPolicy.cpp)
+        cfg       I/P  simConfig             Command line options
+        pool      I/P  threadPool            Threads used to run the experiments
+        shardAlg  O/P  vector<pointPartial>  Partial results of every test, in sweep order
 */
-hddSim fifo(vector<ioReq> req)
+template <class Policy>
+vector<pointPartial> shardAlg(const simConfig &cfg, threadPool &pool)
 {
-    int dhTrack = 100; // Disk head track starts at 100 for each experiment
-    int dhSector = 0;  // Disk head sector starts at 0 for each experiment
-    hddSim sim;
-    sim.totalRequests = req.size();
-    sim.totalTime = 0;
-    sim.avgSeekLength = 0;
+    const int chunks = (sweepLimit(cfg) + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    vector<pointPartial> points(11);
+    vector<int> todo;
+    vector<latencyHist> workerLatency(pool.size());
 
-    for (ioReq r : req)
+    for (int p = 0; p < (int)points.size(); p++)
     {
-        // switch tracks if needed
-        int distance = abs(r.track - dhTrack);
-        float duration = (float)distance * AVG_SEEK_TIME;
-        sim.avgSeekLength += distance;
-        sim.totalTime += duration;
-
-        dhTrack = r.track;                      // set dhTrack to the destination value
-        dhSector = updateSector(sim.totalTime); // accounting for disk spin while seeking
-
-        // calculate rotational latency
-        int sectDiff = 0;
-        if (r.sector >= dhSector)
-            sectDiff = r.sector - dhSector;
-        else
-            sectDiff = (359 - dhSector) + r.sector; // the remaining distance on the disk plus the additional rotation
-        dhSector = updateSector(dhSector, sectDiff);
-        sim.totalTime += sectDiff * (RPMS / 360);
-
-        // calculate transfer time
-        float transferTime = (float)(BLOCK_SIZE * 1024) / (float)6000000000;
-        transferTime *= 1000;
-        sim.totalTime += transferTime;
-
-        float totalAvgAccessTime = AVG_SEEK_TIME + (1 / (2 * RPM)) + transferTime;
-        sim.totalAvgAccessTime += totalAvgAccessTime;
+        pointPartial &point = points[p];
+        point.io = 50 + 10 * p;
+        point.chunks.assign(chunks, chunkPartial());
+        point.latency.clear();
+
+        todo.clear();
+        for (int c = 0; c < chunks; c++)
+            if (shardOwns(cfg, p, c, chunks))
+                todo.push_back(c);
+        sweepChunks<Policy>(cfg, pool, point, todo, workerLatency);
+        updateProgressBar(10 * p, 100, Policy::id);
     }
-
-    sim.totalAvgAccessTime /= req.size();
-    sim.avgSeekLength /= req.size();
-    return sim;
+    return points;
 }
 
 /*
-    hddSim sstf(vector<ioReq> req)
+    bool laneChunk<Policy>(cfg, io, first, count, sims, fixedOrder)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Emulates the performance of a Shortest Service Time First disk scheduling algorithm.
+    date: Oct 16, 2026
+    description: Run the experiments of one chunk with the SIMD lane evaluator, for policies whose
+        service order is fixed. The overload for the other policies does nothing, so laneEvaluate is
+        only instantiated where it applies.
     parameters:
-        req   I/P  vector<ioReq>  Vector of simulated I/O requests
-        sstf  O/P  hddSim         Struct containing simulation statistics
-*/
-hddSim sstf(vector<ioReq> req)
-{
-    int dhTrack = 100; // Disk head track starts at 100 for each experiment
-    int dhSector = 0;  // Disk head sector starts at 0 for each experiment
-    int rSize = req.size();
-    hddSim sim;
-    sim.totalRequests = rSize;
-    sim.totalTime = 0;
-
-    bool ascendingStart = true;
-    bool ascended = false, descended = false;
-
-    // sort request vector then group by tracks
-    quicksort(req, 0, rSize, "sector");
-    quicksort(req, 0, rSize, "track");
-
-    // find best starting point
-    int startIndex = 0;
-    float startTime = 999;
-    for (int x = 0; x < rSize; x++) {
-        // find duration of track traversal
-        int distance = abs(req[x].track - dhTrack);
-        float duration = (float)distance * AVG_SEEK_TIME;
-        int futureSector = updateSector(duration);
-        float futureTime = duration;
-        
-        // account for rotational latency
-        int sectDiff = 0;
-        if (req[x].sector >= futureSector)
-            sectDiff = req[x].sector - futureSector;
-        else
-            sectDiff = (359 - futureSector) + req[x].sector;
+        Policy      I/P  class          Scheduling policy (see schedPolicy.cpp)
+        cfg         I/P  simConfig      Command line options; cfg.seed names the experiments
+        io          I/P  int            Requests per experiment
+        first       I/P  int            Index of the chunk's first experiment
+        count       I/P  int            Experiments in the chunk
+        sims        O/P  hddSim*        Statistics of each experiment, count entries
+        fixedOrder  I/P  true_type      Policy::fixedOrder, as a type
+        laneChunk   O/P  bool           True if the chunk was run, false for the overload that does not
+*/
+template <class Policy>
+bool laneChunk(const simConfig &cfg, int io, int first, int count, hddSim *sims, std::true_type)
+{
+    experimentKey keys[CHUNK_SIZE] = {};
+    for (int e = 0; e < count; e++)
+        keys[e] = experimentKey{cfg.seed, (uint32_t)Policy::id, (uint32_t)(first + e)};
+    laneEvaluate<Policy>(io, keys, count, sims);
+    return true;
+}
 
-        futureTime += sectDiff * (RPMS / 360);
+template <class Policy>
+bool laneChunk(const simConfig &, int, int, int, hddSim *, std::false_type)
+{
+    return false;
+}
 
-        // if evaluated potential time is better than current best
-        if (futureTime < startTime)
+/*
+    void sweepChunks<Policy>(cfg, pool, &point, todo, &workerLatency)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run a list of work chunks of one sweep test across the thread pool, one chunk per
+        task. Experiment e of the test draws its requests from the counter-based generator under
+        (cfg.seed, Policy::id, io, e) (see drawRequests), so they do not depend on which thread,
+        round or shard runs the experiment. Policies with a fixed service order are evaluated in
+        SIMD lane groups unless cfg.lanes is off or a drive cache is simulated; the results are the
+        same either way. Each chunk also keeps the means of its replicates of sampling.block()
+        experiments (see sampling.cpp), of the total time and the FIFO seek control, for the
+        confidence interval.
+    parameters:
+        Policy          I/P  class               Scheduling policy (see schedPolicy.cpp)
+        cfg             I/P  simConfig           Command line options
+        pool            I/P  threadPool          Threads used to run the experiments
+        &point          O/P  pointPartial        Test the chunks belong to; the listed chunks are filled
+        todo            I/P  vector<int>         Indexes of the chunks to run
+        &workerLatency  I/P  vector<latencyHist> One empty histogram per worker, left empty again
+*/
+template <class Policy>
+void sweepChunks(const simConfig &cfg, threadPool &pool, pointPartial &point, const vector<int> &todo,
+                 vector<latencyHist> &workerLatency)
+{
+    // tests run whole replicates, and e % block is an experiment's place in its replicate
+    const int block = sampling.block();
+    const int limit = sweepLimit(cfg);
+    const int io = point.io;
+
+    pool.run((int)todo.size(), [&](int k, int worker) {
+        thread_local driveCache cache;
+        latencySink = &workerLatency[worker];
+        activeCache = cacheSettings.segments > 0 ? &cache : nullptr;
+        int c = todo[k];
+        chunkPartial &part = point.chunks[c];
+        part.sums.totalAvgAccessTime = 0;
+        part.sums.avgReqTime = 0;
+        part.sums.totalReq = 0;
+        part.stats.clear();
+        part.cacheHits = 0;
+        part.sums.seekTime = 0;
+        part.sums.rotationTime = 0;
+        part.sums.transferTime = 0;
+        part.trackSwitches = 0;
+        part.missedRotations = 0;
+
+        int first = c * CHUNK_SIZE;
+        int count = min(limit, first + CHUNK_SIZE) - first;
+        hddSim sims[CHUNK_SIZE];
+
+        // the lane kernels are built for the built-in drive without a cache
+        bool lanes = cfg.lanes && drive.isDefault && activeCache == nullptr &&
+                     laneChunk<Policy>(cfg, io, first, count, sims, std::integral_constant<bool, Policy::fixedOrder>());
+        if (!lanes)
         {
-            startIndex = x;
-            startTime = duration;
+            for (int e = 0; e < count; e++)
+                sims[e] = runExperiment<Policy>(io, experimentKey{cfg.seed, (uint32_t)Policy::id, (uint32_t)(first + e)});
         }
-    }
 
-    // if write head will start in decending order
-    if (req[startIndex].track < dhTrack)
-        ascendingStart = false;
+        for (int e = 0; e < count; e++)
+        {
+            part.sums.totalAvgAccessTime += sims[e].totalAvgAccessTime;
+            part.sums.avgReqTime += sims[e].totalTime;
+            part.sums.totalReq += io;
+            part.cacheHits += sims[e].cacheHits;
+            part.sums.seekTime += sims[e].seekTime;
+            part.sums.rotationTime += sims[e].rotationTime;
+            part.sums.transferTime += sims[e].transferTime;
+            part.trackSwitches += sims[e].trackSwitches;
+            part.missedRotations += sims[e].missedRotations;
+        }
+        for (int b = 0; b < count; b += block)
+        {
+            double control = 0, total = 0;
+            for (int e = b; e < b + block; e++)
+            {
+                control += sims[e].fifoSeek;
+                total += sims[e].totalTime;
+            }
+            part.stats.add(control / block, total / block);
+        }
+        part.done = true;
+        latencySink = nullptr;
+        activeCache = nullptr;
+    });
 
-    // HUB section determines the control flow
-    HUB:
-    if (ascendingStart) // if drive head starts in an ascending direction
+    // integer counts, so the order the workers are merged in does not matter
+    for (latencyHist &h : workerLatency)
     {
-        if (!ascended)
-            goto ASCEND;
-        else if (!descended)
-            goto DESCEND;
-        else
-            goto END;
+        point.latency.merge(h);
+        h.clear();
     }
-    else // if drive head starts in an descending direction
+}
+
+/*
+    results reducePoint(point, chunks)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Turn the first chunks of one sweep test into its results, merging them in index
+        order so the sums come out the same however the chunks were run. The confidence interval is
+        taken over the replicate means, and with sampling.control the average request time is the
+        control variate estimate against the FIFO seek time, whose mean is known exactly. The time
+        components stay plain means, so they only add up to the uncontrolled average.
+    parameters:
+        point        I/P  pointPartial  Test whose chunks are merged; the first chunks must be done
+        chunks       I/P  int           Number of chunks to merge
+        reducePoint  O/P  results       Averages, confidence interval and latency of the test
+*/
+results reducePoint(const pointPartial &point, int chunks)
+{
+    results batchRes; // set up collection results struct
+    batchRes.totalAvgAccessTime = 0;
+    batchRes.avgReqTime = 0;
+    batchRes.totalReq = 0;
+    batchRes.seekTime = 0;
+    batchRes.rotationTime = 0;
+    batchRes.transferTime = 0;
+    runningCov stats;
+    long long hits = 0, switches = 0, missed = 0;
+
+    // merge the chunks in a fixed order
+    for (int c = 0; c < chunks; c++)
     {
-        if (!descended)
-            goto DESCEND;
-        else if (!ascended)
-            goto ASCEND;
-        else
-            goto END;
+        const chunkPartial &part = point.chunks[c];
+        batchRes.totalAvgAccessTime += part.sums.totalAvgAccessTime;
+        batchRes.avgReqTime += part.sums.avgReqTime;
+        batchRes.totalReq += part.sums.totalReq;
+        stats.merge(part.stats);
+        hits += part.cacheHits;
+        batchRes.seekTime += part.sums.seekTime;
+        batchRes.rotationTime += part.sums.rotationTime;
+        batchRes.transferTime += part.sums.transferTime;
+        switches += part.trackSwitches;
+        missed += part.missedRotations;
     }
-    
-    ASCEND:
-    // head is moving in ascending order
-    for (int t = startIndex; t < rSize; t++)
+    batchRes.cacheHitRate = batchRes.totalReq > 0 ? (float)((double)hits / batchRes.totalReq) : 0;
+
+    // convert values into averages
+    batchRes.experiments = (int)stats.n * sampling.block();
+    batchRes.totalAvgAccessTime /= batchRes.experiments;
+    batchRes.avgReqTime /= batchRes.experiments;
+    batchRes.totalReq /= batchRes.experiments;
+    batchRes.seekTime /= batchRes.experiments;
+    batchRes.rotationTime /= batchRes.experiments;
+    batchRes.transferTime /= batchRes.experiments;
+    batchRes.trackSwitches = (float)((double)switches / batchRes.experiments);
+    batchRes.missedRotations = (float)((double)missed / batchRes.experiments);
+    batchRes.ciHalfWidth = (float)stats.halfWidth();
+    if (sampling.control)
     {
-        // check for track switches
-        if (req[t].track != dhTrack)
-        {
-            int distance = abs(req[t].track - dhTrack);
-            float duration = (float)distance * AVG_SEEK_TIME;
-            sim.avgSeekLength += distance;
-            sim.totalTime += duration;
-
-            dhTrack = req[t].track;                 // set dhTrack to the destination value
-            dhSector = updateSector(sim.totalTime); // accounting for disk spin while seeking
-        }
-
-        ioReq r = req[t];
+        batchRes.avgReqTime = (float)stats.controlledMean(fifoSeekMean(point.io));
+        batchRes.ciHalfWidth = (float)stats.controlledHalfWidth();
+    }
+    batchRes.latency = point.latency.summary();
+    return batchRes;
+}
 
-        // calculate rotational latency
-        int sectDiff = 0;
-        if (r.sector >= dhSector)
-            sectDiff = r.sector - dhSector;
-        else
-            sectDiff = (359 - dhSector) + r.sector; // the remaining distance on the disk plus the additional rotation
-        dhSector = updateSector(dhSector, sectDiff);
-        sim.totalTime += sectDiff * (RPMS / 360);
+/*
+    int sweepLimit(cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Experiments each sweep test may run: EXPERIMENTS, or cfg.maxExperiments for an
+        adaptive sweep, rounded up to whole replicates of sampling.block().
+    parameters:
+        cfg         I/P  simConfig  Command line options
+        sweepLimit  O/P  int        Experiments per test
+*/
+int sweepLimit(const simConfig &cfg)
+{
+    const int block = sampling.block();
+    return ((cfg.ciTarget > 0 ? cfg.maxExperiments : EXPERIMENTS) + block - 1) / block * block;
+}
 
-        // calculate transfer time
-        float transferTime = (float)(BLOCK_SIZE * 1024) / (float)6000000000;
-        transferTime *= 1000;
-        sim.totalTime += transferTime;
+/*
+    fusedResults executeFused(cfg, pool)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run every selected scheduling algorithm on the same generated requests of each
+        experiment. Requests are generated once per experiment and handed to each algorithm back to
+        back, so generation is paid once instead of once per algorithm and the algorithms are compared
+        on identical workloads. Besides the usual per-algorithm results, the per-experiment difference
+        in total time against the baseline (the first selected algorithm) is reported as a mean with
+        its standard error.
+    parameters:
+        cfg           I/P  simConfig     Command line options
+        pool          I/P  threadPool    Threads used to run the experiments
+        executeFused  O/P  fusedResults  Results and paired differences for the selected algorithms
+*/
+fusedResults executeFused(const simConfig &cfg, threadPool &pool)
+{
+    const vector<schedEntry> &policies = schedRegistry();
+    const int numAlgs = (int)policies.size();
 
-        // calculate access time
-        float totalAvgAccessTime = AVG_SEEK_TIME + (1 / (2 * RPM)) + transferTime;
-        sim.totalAvgAccessTime += totalAvgAccessTime;
+    // per-chunk sums; differences are summed in double so the variance does not cancel out
+    struct fusedPartial
+    {
+        vector<results> res;
+        vector<double> diffSum;
+        vector<double> diffSq;
+        vector<runningStats> stats;
+        vector<long long> cacheHits;
+        vector<long long> trackSwitches;
+        vector<long long> missedRotations;
+    };
+
+    fusedResults out;
+    out.alg.resize(numAlgs);
+    out.diff.resize(numAlgs);
+    const int chunks = (EXPERIMENTS + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    vector<fusedPartial> partial(chunks);
+    for (fusedPartial &part : partial)
+    {
+        part.res.resize(numAlgs);
+        part.diffSum.resize(numAlgs);
+        part.diffSq.resize(numAlgs);
+        part.stats.resize(numAlgs);
+        part.cacheHits.resize(numAlgs);
+        part.trackSwitches.resize(numAlgs);
+        part.missedRotations.resize(numAlgs);
     }
-    ascended = true;
-    goto HUB; // return to HUB
+    vector<vector<latencyHist>> workerLatency(pool.size(), vector<latencyHist>(numAlgs));
 
-    DESCEND:
-    // head traverses in reverse order
-    for (int t = startIndex; t >= 0; t--)
+    for (int io = 50; io <= 150; io += 10)
     {
-        // check for track switches
-        if (req[t].track != dhTrack)
+        for (vector<latencyHist> &w : workerLatency)
+            for (latencyHist &h : w)
+                h.clear();
+
+        pool.run(chunks, [&](int c, int worker) {
+            thread_local driveCache cache;
+            activeCache = cacheSettings.segments > 0 ? &cache : nullptr;
+            fusedPartial &part = partial[c];
+            for (int a = 0; a < numAlgs; a++)
+            {
+                part.res[a].totalAvgAccessTime = 0;
+                part.res[a].avgReqTime = 0;
+                part.res[a].totalReq = 0;
+                part.diffSum[a] = 0;
+                part.diffSq[a] = 0;
+                part.stats[a].clear();
+                part.cacheHits[a] = 0;
+                part.res[a].seekTime = 0;
+                part.res[a].rotationTime = 0;
+                part.res[a].transferTime = 0;
+                part.trackSwitches[a] = 0;
+                part.missedRotations[a] = 0;
+            }
+
+            int end = min(EXPERIMENTS, (c + 1) * CHUNK_SIZE);
+            for (int e = c * CHUNK_SIZE; e < end; e++)
+            {
+                PROFILE_PHASE(PHASE_SCHEDULE);
+                pooledBatch requests(threadReqPool());
+                generateRequests(io, experimentKey{cfg.seed, STREAM_SHARED, (uint32_t)e}, *requests);
+                float baseline = 0;
+                for (int a : cfg.algs)
+                {
+                    latencySink = &workerLatency[worker][a];
+                    if (activeCache)
+                        activeCache->clear();
+                    hddSim s = policies[a].run(requests->span());
+                    part.res[a].totalAvgAccessTime += s.totalAvgAccessTime;
+                    part.res[a].avgReqTime += s.totalTime;
+                    part.res[a].totalReq += io;
+                    part.stats[a].add(s.totalTime);
+                    part.cacheHits[a] += s.cacheHits;
+                    part.res[a].seekTime += s.seekTime;
+                    part.res[a].rotationTime += s.rotationTime;
+                    part.res[a].transferTime += s.transferTime;
+                    part.trackSwitches[a] += s.trackSwitches;
+                    part.missedRotations[a] += s.missedRotations;
+
+                    if (a == cfg.algs[0])
+                        baseline = s.totalTime;
+                    double d = (double)s.totalTime - baseline;
+                    part.diffSum[a] += d;
+                    part.diffSq[a] += d * d;
+                }
+            }
+            latencySink = nullptr;
+            activeCache = nullptr;
+        });
+
+        // merge the chunks in a fixed order
+        fusedPartial total = partial[0];
+        for (int c = 1; c < chunks; c++)
         {
-            int distance = abs(req[t].track - dhTrack);
-            float duration = (float)distance * AVG_SEEK_TIME;
-            sim.avgSeekLength += distance;
-            sim.totalTime += duration;
+            for (int a = 0; a < numAlgs; a++)
+            {
+                total.res[a].totalAvgAccessTime += partial[c].res[a].totalAvgAccessTime;
+                total.res[a].avgReqTime += partial[c].res[a].avgReqTime;
+                total.res[a].totalReq += partial[c].res[a].totalReq;
+                total.diffSum[a] += partial[c].diffSum[a];
+                total.diffSq[a] += partial[c].diffSq[a];
+                total.stats[a].merge(partial[c].stats[a]);
+                total.cacheHits[a] += partial[c].cacheHits[a];
+                total.res[a].seekTime += partial[c].res[a].seekTime;
+                total.res[a].rotationTime += partial[c].res[a].rotationTime;
+                total.res[a].transferTime += partial[c].res[a].transferTime;
+                total.trackSwitches[a] += partial[c].trackSwitches[a];
+                total.missedRotations[a] += partial[c].missedRotations[a];
+            }
+        }
 
-            dhTrack = req[t].track;                 // set dhTrack to the destination value
-            dhSector = updateSector(sim.totalTime); // accounting for disk spin while seeking
+        for (int a : cfg.algs)
+        {
+            results batchRes = total.res[a];
+            batchRes.cacheHitRate = (float)((double)total.cacheHits[a] / batchRes.totalReq);
+            batchRes.totalAvgAccessTime /= EXPERIMENTS;
+            batchRes.avgReqTime /= EXPERIMENTS;
+            batchRes.totalReq /= EXPERIMENTS;
+            batchRes.seekTime /= EXPERIMENTS;
+            batchRes.rotationTime /= EXPERIMENTS;
+            batchRes.transferTime /= EXPERIMENTS;
+            batchRes.trackSwitches = (float)((double)total.trackSwitches[a] / EXPERIMENTS);
+            batchRes.missedRotations = (float)((double)total.missedRotations[a] / EXPERIMENTS);
+            batchRes.experiments = EXPERIMENTS;
+            batchRes.ciHalfWidth = (float)total.stats[a].halfWidth();
+            for (int w = 1; w < pool.size(); w++)
+                workerLatency[0][a].merge(workerLatency[w][a]);
+            batchRes.latency = workerLatency[0][a].summary();
+            out.alg[a].push_back(batchRes);
+
+            if (a == cfg.algs[0])
+                continue;
+            double mean = total.diffSum[a] / EXPERIMENTS;
+            double var = (total.diffSq[a] - EXPERIMENTS * mean * mean) / (EXPERIMENTS - 1);
+            pairedDiff d;
+            d.meanDiff = (float)mean;
+            d.stdErr = (float)sqrt(max(0.0, var) / EXPERIMENTS);
+            out.diff[a].push_back(d);
         }
+        updateProgressBar(io - 50, 100, 0);
+    }
+    return out;
+}
 
-        ioReq r = req[t];
+/*
+    vector<eventResults> executeEvents(cfg, pool)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run the discrete-event simulation for every selected algorithm, one algorithm per
+        task. Every algorithm sees the same arrival stream.
+    parameters:
+        cfg            I/P  simConfig             Command line options
+        pool           I/P  threadPool            Threads used to run the simulations
+        executeEvents  O/P  vector<eventResults>  Results in cfg.algs order
+*/
+vector<eventResults> executeEvents(const simConfig &cfg, threadPool &pool)
+{
+    vector<eventResults> res(cfg.algs.size());
+    pool.run((int)cfg.algs.size(), [&](int k, int) {
+        res[k] = schedRegistry()[cfg.algs[k]].events(cfg.arrivals);
+    });
+    return res;
+}
 
-        // calculate rotational latency
-        int sectDiff = 0;
-        if (r.sector >= dhSector)
-            sectDiff = r.sector - dhSector;
-        else
-            sectDiff = (359 - dhSector) + r.sector; // the remaining distance on the disk plus the additional rotation
-        dhSector = updateSector(dhSector, sectDiff);
-        sim.totalTime += sectDiff * (RPMS / 360);
+/*
+    vector<streamResults> executeStream(cfg, pool)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run one streaming experiment for every selected algorithm, one algorithm per task.
+        Every algorithm sees the same request stream.
+    parameters:
+        cfg            I/P  simConfig              Command line options
+        pool           I/P  threadPool             Threads used to run the experiments
+        executeStream  O/P  vector<streamResults>  Results in cfg.algs order
+*/
+vector<streamResults> executeStream(const simConfig &cfg, threadPool &pool)
+{
+    vector<streamResults> res(cfg.algs.size());
+    pool.run((int)cfg.algs.size(), [&](int k, int) {
+        res[k] = schedRegistry()[cfg.algs[k]].stream(cfg.stream);
+    });
+    return res;
+}
 
-        // calculate transfer time
-        float transferTime = (float)(BLOCK_SIZE * 1024) / (float)6000000000;
-        transferTime *= 1000;
-        sim.totalTime += transferTime;
+/*
+    vector<arrayResults> executeArray(cfg, pool)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run one streamed disk array experiment for every selected algorithm, one algorithm
+        after the other, each spreading its drives over the whole pool. Every algorithm sees the
+        same logical request stream.
+    parameters:
+        cfg           I/P  simConfig             Command line options
+        pool          I/P  threadPool            Threads used to run the drives
+        executeArray  O/P  vector<arrayResults>  Results in cfg.algs order
+*/
+vector<arrayResults> executeArray(const simConfig &cfg, threadPool &pool)
+{
+    vector<arrayResults> res(cfg.algs.size());
+    for (size_t k = 0; k < cfg.algs.size(); k++)
+        res[k] = schedRegistry()[cfg.algs[k]].array(cfg.array, cfg.stream, pool);
+    return res;
+}
 
-        // calculate access time
-        float totalAvgAccessTime = AVG_SEEK_TIME + (1 / (2 * RPM)) + transferTime;
-        sim.totalAvgAccessTime += totalAvgAccessTime;
-    }
-    descended = true;
-    goto HUB; // return to HUB
+/*
+    hddSim runExperiment<Policy>(n, key)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Generate one experiment's requests and run one scheduling policy on them. Every
+        experiment is a fresh drive, so the thread's drive cache, if any, starts empty.
+    parameters:
+        Policy         I/P  class          Scheduling policy (see schedPolicy.cpp)
+        n              I/P  int            Number of requests in the experiment
+        key            I/P  experimentKey  Experiment whose requests are generated
+        runExperiment  O/P  hddSim         Struct containing simulation statistics
+*/
+template <class Policy>
+hddSim runExperiment(int n, experimentKey key)
+{
+    PROFILE_PHASE(PHASE_SCHEDULE);
+    pooledBatch requests(threadReqPool());
+    generateRequests(n, key, *requests); // generate batch of I/O requests
+    if (activeCache)
+        activeCache->clear();
+    hddSim sim = Policy::run(requests->span());
+    if (sampling.control)
+        sim.fifoSeek = (float)fifoSeekControl(requests->span());
+    return sim;
+}
+
+/*
+    hddSim fifo(reqSpan req)
+    author: Gherkin
+    date: Nov 22, 2020
+    description: Emulates the performance of a First-In-First-Out disk scheduling algorithm.
+    parameters:
+        req   I/P  reqSpan  View of simulated I/O requests
+        fifo  O/P  hddSim   Struct containing simulation statistics
+*/
+hddSim fifo(reqSpan req)
+{
+    headState head = startHead(); // Disk head starts mid-disk, sector 0 for each experiment
+    hddSim sim = newSim(req.size);
+
+    serviceSequence(head, req, 0, req.size - 1, sim);
 
-    END:
-    sim.totalAvgAccessTime /= req.size();
-    sim.avgSeekLength /= req.size();
+    finishSim(sim);
     return sim;
 }
 
 /*
-    hddSim scan(vector<ioReq> req)
+    hddSim sstf(reqSpan in)
     author: Gherkin
     date: Nov 22, 2020
-    description: Emulates the performance of a SCAN disk scheduling algorithm.
+    description: Emulates the performance of a Shortest Service Time First disk scheduling algorithm.
+        After every request the head moves to the nearest track that still has pending requests
+        (see sstfService).
     parameters:
-        req   I/P  vector<ioReq>  Vector of simulated I/O requests
-        scan  O/P  hddSim         Struct containing simulation statistics
+        in    I/P  reqSpan  View of simulated I/O requests
+        sstf  O/P  hddSim   Struct containing simulation statistics
 */
-hddSim scan(vector<ioReq> req)
+hddSim sstf(reqSpan in)
 {
-    int dhTrack = 100; // Disk head track starts at 100 for each experiment
-    int dhSector = 0;  // Disk head sector starts at 0 for each experiment
-    int rSize = req.size();
-    hddSim sim;
-    sim.totalRequests = rSize;
-    sim.totalTime = 0;
+    headState head = startHead(); // Disk head starts mid-disk, sector 0 for each experiment
+    hddSim sim = newSim(in.size);
+
+    sstfService(head, in, sim);
 
-    // sort request vector then group by tracks
-    quicksort(req, 0, rSize, "sector");
-    quicksort(req, 0, rSize, "track");
+    finishSim(sim);
+    return sim;
+}
 
-    // find the first value in track 100. Not very optimized.
-    int startIndex = 0;
+/*
+    void sstfService(&head, in, &sim)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Service a batch of requests in SSTF order from wherever the head is. Requests are
+        sorted into per-track runs and the tracks with pending requests are kept in an occupancy
+        bitmap, so each pick is a find-next/find-previous set bit rather than a scan of the whole
+        batch. Once on a track, its requests are serviced in rotational order starting from the
+        sector under the head.
+    parameters:
+        &head  I/P  headState  Head position and clock; updated as requests are serviced
+        in     I/P  reqSpan    View of simulated I/O requests
+        &sim   O/P  hddSim     Experiment the costs are added to
+*/
+void sstfService(headState &head, reqSpan in, hddSim &sim)
+{
+    int rSize = in.size;
+
+    // sort a pooled copy of the requests then group by tracks
+    pooledBatch sorted(threadReqPool());
+    reqBatch &req = *sorted;
+    sortRequests(in, req);
+    reqSpan ordered = req.span();
+
+    // index the run of requests on each track
+    thread_local occupancyBitmap occ;
+    thread_local vector<int> runStart;
+    occ.reset(drive.tracks);
+    runStart.resize(drive.tracks + 1);
     for (int x = 0; x < rSize; x++)
     {
-        if (req[x].track >= dhTrack)
+        if (!occ.test(req.track[x]))
         {
-            startIndex = x;
-            break;
+            occ.set(req.track[x]);
+            runStart[req.track[x]] = x;
         }
     }
 
-    // head is moving ascending order first
-    for (int t = startIndex; t < rSize; t++)
+    for (int t = nearestTrack(occ, head.track); t >= 0; t = nearestTrack(occ, head.track))
     {
-        // check for track switches
-        if (req[t].track != dhTrack)
-        {
-            int distance = abs(req[t].track - dhTrack);
-            float duration = (float)distance * AVG_SEEK_TIME;
-            sim.avgSeekLength += distance;
-            sim.totalTime += duration;
-
-            dhTrack = req[t].track;                 // set dhTrack to the destination value
-            dhSector = updateSector(sim.totalTime); // accounting for disk spin while seeking
-        }
-
-        ioReq r = req[t];
-
-        // calculate rotational latency
-        int sectDiff = 0;
-        if (r.sector >= dhSector)
-            sectDiff = r.sector - dhSector;
-        else
-            sectDiff = (359 - dhSector) + r.sector; // the remaining distance on the disk plus the additional rotation
-        dhSector = updateSector(dhSector, sectDiff);
-        sim.totalTime += sectDiff * (RPMS / 360);
-
-        // calculate transfer time
-        float transferTime = (float)(BLOCK_SIZE * 1024) / (float)6000000000;
-        transferTime *= 1000;
-        sim.totalTime += transferTime;
-
-        // calculate access time
-        float totalAvgAccessTime = AVG_SEEK_TIME + (1 / (2 * RPM)) + transferTime;
-        sim.totalAvgAccessTime += totalAvgAccessTime;
+        occ.clear(t);
+        int first = runStart[t];
+        int last = first;
+        while (last + 1 < rSize && req.track[last + 1] == t)
+            last++;
+
+        // start with the first sector the head reaches after the seek, then wrap around
+        const int *begin = ordered.sector + first, *end = ordered.sector + last + 1;
+        int k = first + (int)(lower_bound(begin, end, sectorAfterSeek(head, t)) - begin);
+        if (k <= last)
+            serviceSequence(head, ordered, k, last, sim);
+        if (k > first)
+            serviceSequence(head, ordered, first, k - 1, sim);
     }
+}
 
-    // head traverses back in reverse order
-    for (int t = startIndex; t >= 0; t--)
-    {
-        // check for track switches
-        if (req[t].track != dhTrack)
-        {
-            int distance = abs(req[t].track - dhTrack);
-            float duration = (float)distance * AVG_SEEK_TIME;
-            sim.avgSeekLength += distance;
-            sim.totalTime += duration;
-
-            dhTrack = req[t].track;                 // set dhTrack to the destination value
-            dhSector = updateSector(sim.totalTime); // accounting for disk spin while seeking
-        }
-
-        ioReq r = req[t];
-
-        // calculate rotational latency
-        int sectDiff = 0;
-        if (r.sector >= dhSector)
-            sectDiff = r.sector - dhSector;
-        else
-            sectDiff = (359 - dhSector) + r.sector; // the remaining distance on the disk plus the additional rotation
-        dhSector = updateSector(dhSector, sectDiff);
-        sim.totalTime += sectDiff * (RPMS / 360);
+/*
+    hddSim scan(reqSpan in)
+    author: Gherkin
+    date: Nov 22, 2020
+    description: Emulates the performance of a SCAN disk scheduling algorithm. The head moves up
+        through the requests to the last track of the disk, then back down through the rest.
+    parameters:
+        in    I/P  reqSpan  View of simulated I/O requests
+        scan  O/P  hddSim   Struct containing simulation statistics
+*/
+hddSim scan(reqSpan in)
+{
+    return runElevator<scanPolicy>(in);
+}
 
-        // calculate transfer time
-        float transferTime = (float)(BLOCK_SIZE * 1024) / (float)6000000000;
-        transferTime *= 1000;
-        sim.totalTime += transferTime;
+/*
+    hddSim lifo(reqSpan req)
+    author: Gherkin
+    date: Nov 22, 2020
+    description: Emulates the performance of a Last-In-First-Out disk scheduling algorithm.
+    parameters:
+        req   I/P  reqSpan  View of simulated I/O requests
+        lifo  O/P  hddSim   Struct containing simulation statistics
+*/
+hddSim lifo(reqSpan req)
+{
+    headState head = startHead(); // Disk head starts mid-disk, sector 0 for each experiment
+    hddSim sim = newSim(req.size);
 
-        // calculate access time
-        float totalAvgAccessTime = AVG_SEEK_TIME + (1 / (2 * RPM)) + transferTime;
-        sim.totalAvgAccessTime += totalAvgAccessTime;
-    }
+    serviceSequence(head, req, req.size - 1, 0, sim);
 
-    sim.totalAvgAccessTime /= req.size();
-    sim.avgSeekLength /= req.size();
+    finishSim(sim);
     return sim;
 }
 
 /*
-    hddSim lifo(vector<ioReq> req)
+    hddSim cscan(reqSpan in)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Emulates the performance of a Last-In-First-Out disk scheduling algorithm.
+    date: Oct 16, 2026
+    description: Emulates the performance of a C-SCAN disk scheduling algorithm. The head moves up
+        through the requests to the last track, returns to track 0 and moves up again.
     parameters:
-        req   I/P  vector<ioReq>  Vector of simulated I/O requests
-        lifo  O/P  hddSim         Struct containing simulation statistics
+        in     I/P  reqSpan  View of simulated I/O requests
+        cscan  O/P  hddSim   Struct containing simulation statistics
 */
-hddSim lifo(vector<ioReq> req)
+hddSim cscan(reqSpan in)
 {
-    int dhTrack = 100; // Disk head track starts at 100 for each experiment
-    int dhSector = 0;  // Disk head sector starts at 0 for each experiment
-    hddSim sim;
-    int rSize = req.size();
-    sim.totalRequests = req.size();
-    sim.totalTime = 0;
-    sim.avgSeekLength = 0;
-
-    while (req.size() != 0)
-    {
-        ioReq r = req.back();
+    return runElevator<cscanPolicy>(in);
+}
 
-        // switch tracks if needed
-        int distance = abs(r.track - dhTrack);
-        float duration = (float)distance * AVG_SEEK_TIME;
-        sim.avgSeekLength += distance;
-        sim.totalTime += duration;
+/*
+    hddSim look(reqSpan in)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Emulates the performance of a LOOK disk scheduling algorithm. Like SCAN, but the head
+        turns around at the last request instead of the last track.
+    parameters:
+        in    I/P  reqSpan  View of simulated I/O requests
+        look  O/P  hddSim   Struct containing simulation statistics
+*/
+hddSim look(reqSpan in)
+{
+    return runElevator<lookPolicy>(in);
+}
 
-        dhTrack = r.track;                      // set dhTrack to the destination value
-        dhSector = updateSector(sim.totalTime); // accounting for disk spin while seeking
+/*
+    hddSim clook(reqSpan in)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Emulates the performance of a C-LOOK disk scheduling algorithm. The head moves up to
+        the last request, jumps to the lowest request and moves up again.
+    parameters:
+        in     I/P  reqSpan  View of simulated I/O requests
+        clook  O/P  hddSim   Struct containing simulation statistics
+*/
+hddSim clook(reqSpan in)
+{
+    return runElevator<clookPolicy>(in);
+}
 
-        // calculate rotational latency
-        int sectDiff = 0;
-        if (r.sector >= dhSector)
-            sectDiff = r.sector - dhSector;
-        else
-            sectDiff = (359 - dhSector) + r.sector; // the remaining distance on the disk plus the additional rotation
-        dhSector = updateSector(dhSector, sectDiff);
-        sim.totalTime += sectDiff * (RPMS / 360);
+/*
+    hddSim nstepScan(reqSpan in)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Emulates the performance of an N-step SCAN disk scheduling algorithm. Requests are
+        taken in sub-queues of nstepSize in arrival order, each swept in full before the next.
+    parameters:
+        in         I/P  reqSpan  View of simulated I/O requests
+        nstepScan  O/P  hddSim   Struct containing simulation statistics
+*/
+hddSim nstepScan(reqSpan in)
+{
+    return runElevator<nstepPolicy>(in);
+}
 
-        // calculate transfer time
-        float transferTime = (float)(BLOCK_SIZE * 1024) / (float)6000000000;
-        transferTime *= 1000;
-        sim.totalTime += transferTime;
+/*
+    hddSim fscan(reqSpan in)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Emulates the performance of an FSCAN disk scheduling algorithm. Requests that arrive
+        during a sweep wait for the next one. In the sweep every request is present at time zero, so
+        this is a single LOOK sweep; the difference shows in the event simulation (-e).
+    parameters:
+        in     I/P  reqSpan  View of simulated I/O requests
+        fscan  O/P  hddSim   Struct containing simulation statistics
+*/
+hddSim fscan(reqSpan in)
+{
+    return runElevator<fscanPolicy>(in);
+}
 
-        // calculate access time
-        float totalAvgAccessTime = AVG_SEEK_TIME + (1 / (2 * RPM)) + transferTime;
-        sim.totalAvgAccessTime += totalAvgAccessTime;
+/*
+    hddSim runElevator<Policy>(in)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Plan and service a batch of requests with one of the elevator algorithms (see
+        elevatorService).
+    parameters:
+        Policy       I/P  class    Elevator policy whose sweepPlan is used (see schedPolicy.cpp)
+        in           I/P  reqSpan  View of simulated I/O requests
+        runElevator  O/P  hddSim   Struct containing simulation statistics
+*/
+template <class Policy>
+hddSim runElevator(reqSpan in)
+{
+    headState head = startHead(); // Disk head starts mid-disk, sector 0 for each experiment
+    hddSim sim = newSim(in.size);
 
-        req.pop_back();
-    }
+    elevatorService<Policy>(head, in, sim);
 
-    sim.totalAvgAccessTime /= rSize;
-    sim.avgSeekLength /= rSize;
+    finishSim(sim);
     return sim;
 }
 
 /*
-    vector<ioReq> generateRequests(n, seed)
+    void elevatorService<Policy>(&head, in, &sim)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Randomly generate a collection of simulated I/O requests.
+    date: Oct 16, 2026
+    description: Service a batch of requests with an elevator algorithm from wherever the head is.
+        The plan is built by Policy::sweepPlan in pooled batches and serviced in one pass.
     parameters:
-        n                 I/P  int            Number of requests to generate
-        seed              I/P  unsigned       Randomization seed
-        generateRequests  O/P  vector<ioReq>  Vector of simulated I/O requests 
+        Policy I/P  class      Elevator policy whose sweepPlan is used (see schedPolicy.cpp)
+        &head  I/P  headState  Head position and clock; updated as requests are serviced
+        in     I/P  reqSpan    View of simulated I/O requests
+        &sim   O/P  hddSim     Experiment the costs are added to
 */
-vector<ioReq> generateRequests(int n, unsigned seed)
+template <class Policy>
+void elevatorService(headState &head, reqSpan in, hddSim &sim)
 {
-    vector<ioReq> requests;
-    default_random_engine generator;
-    generator.seed(seed);
-    uniform_int_distribution<int> trackDistr(0, TRACKS - 1);
-    uniform_int_distribution<int> sectorDistr(0, SECTORS - 1);
+    pooledBatch sorted(threadReqPool()), plan(threadReqPool());
+    Policy::sweepPlan(in, head.track, *sorted, *plan);
+    if (plan->size() > 0)
+        serviceSequence(head, plan->span(), 0, plan->size() - 1, sim);
+}
 
-    for (int k = 0; k < n; k++)
+/*
+    void generateRequests(n, key, &requests)
+    author: Gherkin
+    date: Nov 22, 2020
+    description: Randomly generate a collection of simulated I/O requests on the simulated drive
+        (see drawRequests). The requests depend only on the key and n, never on what was generated
+        before. The batch is overwritten in place, so a batch reused from a pool does not need to
+        allocate. Sampling modes other than uniform are drawn by sampleRequests.
+    parameters:
+        n         I/P  int            Number of requests to generate
+        key       I/P  experimentKey  Experiment whose requests are generated
+        requests  O/P  reqBatch       Batch of simulated I/O requests
+*/
+void generateRequests(int n, experimentKey key, reqBatch &requests)
+{
+    PROFILE_PHASE(PHASE_GENERATE);
+    if (sampling.mode != 'u')
     {
-        int t = trackDistr(generator);
-        int s = sectorDistr(generator);
-        ioReq *r = new ioReq(t, s);
-        requests.push_back(*r);
+        sampleRequests(n, key, requests);
+        return;
     }
-
-    return requests;
+    requests.resize(n);
+    drawRequests(key, n, 0, n, requests.track.data(), requests.sector.data());
 }
 
 /*
     void printResults(res)
     author: Gherkin
     date: Nov 22, 2020
-    description: Apply stylization and print algorithm test results to the console.
+    description: Apply stylization and print algorithm test results to the console. The latency
+        columns are percentiles of the completion time of every request of every experiment; the
+        last two are the 95 % confidence interval of the average request time and the number of
+        experiments it was taken over. With a drive cache, the share of requests it served follows.
+        With --breakdown, so do the mean seek, rotation and transfer time of an experiment, which
+        add up to its average request time, and its mean track switches and missed rotations.
     parameters:
         res  I/P  vector<results>  All testing results for one algorithm
 */
 void printResults(vector<results> res)
 {
-    cout << " T#  |  Avg Req Time |  Requests   |    Avg Access Time \n";
-    for (int c = 0; c < res.size(); c++)
+    const bool cached = cacheSettings.segments > 0;
+    cout << " T#  |  Avg Req Time |  Requests   |    Avg Access Time |    p50     |    p90     |    p99     |   p99.9    |    Max     |  95% CI     |  Exps"
+         << (cached ? "  | Hits" : "")
+         << (showBreakdown ? "    |    Seek    |  Rotation  |  Transfer  | Switches |  Missed\n" : "\n");
+    for (int c = 0; c < (int)res.size(); c++)
     {
-        string num = "[0" + to_string(c) + "]\t";
-        if (c >= 10)
-            num = "[" + to_string(c) + "]\t";
-        cout << num;
-        //cout << to_string(res[c].avgReqTime) + " ms  \t";
-        printf("%.3f ms\t",res[c].avgReqTime);
-        cout << to_string(res[c].totalReq) + " req  \t";
-        cout << to_string(res[c].totalAvgAccessTime) + " ms\n";
+        const latencySummary &l = res[c].latency;
+        printf("[%02d]\t%.3f ms\t%d req  \t%f ms\t", c, res[c].avgReqTime, res[c].totalReq, res[c].totalAvgAccessTime);
+        printf("%.3f ms\t%.3f ms\t%.3f ms\t%.3f ms\t%.3f ms\t", l.p50, l.p90, l.p99, l.p999, l.max);
+        printf("+/-%.3f ms\t%d", res[c].ciHalfWidth, res[c].experiments);
+        if (cached)
+            printf("\t%.2f %%", res[c].cacheHitRate * 100);
+        if (showBreakdown)
+            printf("\t%.3f ms\t%.3f ms\t%.3f ms\t%.1f\t%.1f", res[c].seekTime, res[c].rotationTime,
+                   res[c].transferTime, res[c].trackSwitches, res[c].missedRotations);
+        printf("\n");
     }
     cout << endl;
 }
 
 /*
-    void updateProgressBar(p, total, alg)
+    void printPairedResults(diff)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Print a graphical indicator of the current test's progression.
+    date: Oct 16, 2026
+    description: Print the paired per-experiment differences against the FIFO baseline.
     parameters:
-        p      I/P  int   Progression of execution loop
-        total  I/P  int   End point of loop
-        alg    I/P  char  Character representation of current algorithm
+        diff  I/P  vector<pairedDiff>  Paired differences for one algorithm
+*/
+void printPairedResults(const vector<pairedDiff> &diff)
+{
+    cout << " T#  |  Mean Diff    |  Std Error  \n";
+    for (int c = 0; c < (int)diff.size(); c++)
+        printf("[%02d]\t%+.3f ms\t%.3f ms\n", c, diff[c].meanDiff, diff[c].stdErr);
+    cout << endl;
+}
 
+/*
+    void printEventResults(cfg, res)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Print the discrete-event simulation results of every selected algorithm.
+    parameters:
+        cfg  I/P  simConfig             Command line options
+        res  I/P  vector<eventResults>  Results in cfg.algs order
 */
-void updateProgressBar(int p, int total, char alg)
+void printEventResults(const simConfig &cfg, const vector<eventResults> &res)
 {
-    float progress = (float)p / total;
-    if (progress == 1)
+    cout << " Alg  |  Completed  |  Throughput  |  Mean Resp   |  Mean Wait   |  p50 Resp  |  p99 Resp  | p99.9 Resp |  Max Resp    |  Util  |  Events/s\n";
+    for (int a = 0; a < (int)res.size(); a++)
     {
-        cout << "Algorithm " << (char)toupper(alg) << " complete.              \n\n";
-        return;
+        const eventResults &r = res[a];
+        printf("%-6s\t%lld\t%.1f req/s\t%.3f ms\t%.3f ms\t%.3f ms\t%.3f ms\t%.3f ms\t%.3f ms\t%.1f %%\t%.2e\n",
+               schedRegistry()[cfg.algs[a]].name, r.completed, r.throughput, r.meanResponse, r.meanWait,
+               r.response.p50, r.response.p99, r.response.p999, r.maxResponse, r.utilization * 100,
+               r.wallSeconds > 0 ? r.events / r.wallSeconds : 0.0);
     }
+    cout << endl;
+}
 
-    else
+/*
+    void printStreamResults(cfg, res)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Print the streaming results of every selected algorithm. Latencies are measured
+        from the moment a request's window was admitted to the scheduler. With --coalesce, Merged is
+        the share of requests folded into another, and Hits are of the requests left.
+    parameters:
+        cfg  I/P  simConfig              Command line options
+        res  I/P  vector<streamResults>  Results in cfg.algs order
+*/
+void printStreamResults(const simConfig &cfg, const vector<streamResults> &res)
+{
+    const bool cached = cacheSettings.segments > 0, merging = mergeSettings.maxBlocks > 0;
+    cout << " Alg  |  Requests   |   Sim Time   |  Time/Req  |  Avg Seek  |    p50     |    p99     |   p99.9    |    Max     |  Req/s"
+         << (merging ? "     | Merged" : "") << (cached ? "     | Hits\n" : "\n");
+    for (int a = 0; a < (int)res.size(); a++)
     {
-        int barWidth = 30;
-        int pos = barWidth * progress;
-        //cout << "[";
+        const streamResults &r = res[a];
+        printf("%-6s\t%lld\t%.3f s\t%.4f ms\t%.2f\t%.3f ms\t%.3f ms\t%.3f ms\t%.3f ms\t%.2e",
+               schedRegistry()[cfg.algs[a]].name, r.requests, r.simTime / 1000,
+               r.requests > 0 ? r.simTime / r.requests : 0.0, r.avgSeek, r.latency.p50, r.latency.p99,
+               r.latency.p999, r.latency.max, r.wallSeconds > 0 ? r.requests / r.wallSeconds : 0.0);
+        const long long ios = r.requests - r.merged;
+        if (merging)
+            printf("\t%.2f %%", r.requests > 0 ? 100.0 * r.merged / r.requests : 0.0);
+        if (cached)
+            printf("\t%.2f %%", ios > 0 ? 100.0 * r.cacheHits / ios : 0.0);
+        printf("\n");
+    }
+    cout << endl;
+}
 
-        char f = 178, e = 176;
+/*
+    void printArrayResults(cfg, res)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Print the disk array results of every selected algorithm. Throughput is logical
+        requests per second of simulated time until the busiest drive finished; imbalance is that
+        time over the mean drive's. Latencies are those of the drive requests, measured from the
+        moment their window was admitted to their drive. With --coalesce, Drive I/Os are counted
+        after merging and Merged is the share of the drive requests folded into another.
+    parameters:
+        cfg  I/P  simConfig             Command line options
+        res  I/P  vector<arrayResults>  Results in cfg.algs order
+*/
+void printArrayResults(const simConfig &cfg, const vector<arrayResults> &res)
+{
+    const char *level = cfg.array.level == RAID_0 ? "RAID-0" : (cfg.array.level == RAID_1 ? "RAID-1" : "RAID-10");
+    printf("%s array of %d drives, stripe %d blocks, %.0f%% writes\n", level, cfg.array.disks, cfg.array.stripe,
+           cfg.array.writeFraction * 100);
+    const bool cached = cacheSettings.segments > 0, merging = mergeSettings.maxBlocks > 0;
+    cout << " Alg  |  Requests   |  Drive I/Os  |   Sim Time   |  Req/s  | Imbalance |  Avg Seek  |    p50     |    p99     |   p99.9    |    Max     | Wall Req/s"
+         << (merging ? " | Merged" : "") << (cached ? " | Hits\n" : "\n");
+    for (int a = 0; a < (int)res.size(); a++)
+    {
+        const arrayResults &r = res[a];
+        printf("%-6s\t%lld\t%lld\t%.3f s\t%.1f\t%.3f\t%.2f\t%.3f ms\t%.3f ms\t%.3f ms\t%.3f ms\t%.2e",
+               schedRegistry()[cfg.algs[a]].name, r.requests, r.ios, r.simTime / 1000,
+               r.simTime > 0 ? r.requests / (r.simTime / 1000) : 0.0,
+               r.meanDriveTime > 0 ? r.simTime / r.meanDriveTime : 0.0, r.avgSeek, r.latency.p50, r.latency.p99,
+               r.latency.p999, r.latency.max, r.wallSeconds > 0 ? r.requests / r.wallSeconds : 0.0);
+        if (merging)
+            printf("\t%.2f %%", r.ios + r.merged > 0 ? 100.0 * r.merged / (r.ios + r.merged) : 0.0);
+        if (cached)
+            printf("\t%.2f %%", r.ios > 0 ? 100.0 * r.cacheHits / r.ios : 0.0);
+        printf("\n");
+    }
+    cout << endl;
+}
 
-        for (int i = 0; i < barWidth; ++i)
+/*
+    void reportSweep(cfg, algResults, &sink)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Print the sweep results of every selected algorithm as tables, or write them
+        through the sink after the run's parameters. A build with HDDSIM_PROFILE follows them with
+        the time the run spent in each phase (see reportProfile).
+    parameters:
+        cfg         I/P  simConfig                Command line options
+        algResults  I/P  vector<vector<results>>  Results per algorithm, indexed like the policy registry
+        &sink       I/P  resultSink               Sink in cfg.format on stdout; unused for tables
+*/
+void reportSweep(const simConfig &cfg, const vector<vector<results>> &algResults, resultSink &sink)
+{
+    const vector<schedEntry> &policies = schedRegistry();
+    if (cfg.format == 't')
+    {
+        for (int a : cfg.algs)
         {
-            if (i <= pos)
-                cout << f;
-            else
-                cout << '_';
+            cout << policies[a].name << " Results:\n";
+            printResults(algResults[a]);
         }
-        cout << " " << int(progress * 100.0) << " %\r";
-        cout.flush();
-
-        if (progress == 1)
-            cout << endl
-                 << endl;
+        reportProfile(sink, true);
+        return;
     }
+
+    writeParams(sink, cfg, "sweep");
+    for (int a : cfg.algs)
+        writeResults(sink, policies[a].name, algResults[a]);
+    reportProfile(sink, false);
 }
 
 /*
-    void quicksort(&req, left, right, comparison)
+    void writeParams(&sink, cfg, mode)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Use a Quicksort algorithm to sort I/O requests by either Sector or Track values.
+    date: Oct 16, 2026
+    description: Write the parameters of the run as a "params" record, the first one of every
+        machine-readable output.
     parameters:
-        &req        I/P  vector<ioReq>  Vector of I/O requests to be sorted
-        left        I/P  int            Left most point of vector
-        right       I/P  int            Right most point of vector
-        comparison  I/P  string         Indicating what value should be compared
+        &sink  I/P  resultSink  Sink the record is written to
+        cfg    I/P  simConfig   Command line options
+        mode   I/P  char*       sweep, fused, events, stream or array
+*/
+void writeParams(resultSink &sink, const simConfig &cfg, const char *mode)
+{
+    char algs[SINK_LINE / 2];
+    size_t used = 0;
+    algs[0] = 0;
+    for (size_t k = 0; k < cfg.algs.size(); k++)
+        used += snprintf(algs + used, sizeof algs - min(used, sizeof algs - 1), "%s%s", k ? "," : "",
+                         schedRegistry()[cfg.algs[k]].name);
+    const char samplingNames[5] = {'u', 'a', 's', 'q', 0};
+    const char *samplingText[4] = {"uniform", "antithetic", "stratified", "sobol"};
+
+    sink.begin("params");
+    sink.field("mode", mode);
+    sink.field("algs", algs);
+    sink.field("threads", cfg.threads);
+    sink.field("seed", (long long)cfg.seed);
+    sink.field("lanes", cfg.lanes);
+    sink.field("drive", cfg.drivePath ? cfg.drivePath : "built-in");
+    sink.field("tracks", drive.tracks);
+    sink.field("rpm", drive.rpm);
+    sink.field("zones", (int)drive.zones.size());
+    sink.field("first_requests", 50);
+    sink.field("last_requests", 150);
+    sink.field("requests_step", 10);
+    sink.field("experiments", EXPERIMENTS);
+    sink.field("ci_target", cfg.ciTarget);
+    sink.field("min_experiments", cfg.minExperiments);
+    sink.field("max_experiments", cfg.maxExperiments);
+    sink.field("sampling", samplingText[strchr(samplingNames, sampling.mode) - samplingNames]);
+    sink.field("control", sampling.control);
+    sink.field("nstep", nstepSize);
+    sink.field("cache_segments", cacheSettings.segments);
+    sink.field("coalesce_blocks", mergeSettings.maxBlocks);
+    sink.field("arrival_rate", cfg.arrivals.rate);
+    sink.field("horizon_s", cfg.arrivals.horizon / 1000);
+    sink.field("burst_on_ms", cfg.arrivals.burstOn);
+    sink.field("burst_off_ms", cfg.arrivals.burstOff);
+    sink.field("stream_requests", cfg.stream.requests);
+    sink.field("window", cfg.stream.window);
+    sink.field("array", cfg.array.level == 0 ? "" : (cfg.array.level == RAID_0 ? "raid0" : (cfg.array.level == RAID_1 ? "raid1" : "raid10")));
+    sink.field("disks", cfg.array.disks);
+    sink.field("stripe_blocks", cfg.array.stripe);
+    sink.field("write_fraction", cfg.array.writeFraction);
+    sink.field("trace", cfg.tracePath ? cfg.tracePath : "");
+    sink.end();
+}
 
+/*
+    void writeResults(&sink, alg, res)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Write one algorithm's sweep results, one "sweep" record per test. The time
+        components and counts are means per experiment, like avg_req_ms.
+    parameters:
+        &sink  I/P  resultSink       Sink the records are written to
+        alg    I/P  char*            Algorithm name
+        res    I/P  vector<results>  All testing results for the algorithm
 */
-void quicksort(vector<ioReq> &req, int left, int right, string comparison)
+void writeResults(resultSink &sink, const char *alg, const vector<results> &res)
 {
-    if (left < right)
+    for (int c = 0; c < (int)res.size(); c++)
     {
-        int pivot;
-        if (comparison == "sector")
-            pivot = partitionBySector(req, left, right);
-        else
-            pivot = partitionByTrack(req, left, right);
-
-        quicksort(req, left, pivot - 1, comparison);
-        quicksort(req, pivot, right, comparison);
+        const latencySummary &l = res[c].latency;
+        sink.begin("sweep");
+        sink.field("alg", alg);
+        sink.field("test", c);
+        sink.field("requests", res[c].totalReq);
+        sink.field("experiments", res[c].experiments);
+        sink.field("avg_req_ms", res[c].avgReqTime);
+        sink.field("ci_half_width_ms", res[c].ciHalfWidth);
+        sink.field("avg_access_ms", res[c].totalAvgAccessTime);
+        sink.field("p50_ms", l.p50);
+        sink.field("p90_ms", l.p90);
+        sink.field("p99_ms", l.p99);
+        sink.field("p999_ms", l.p999);
+        sink.field("max_ms", l.max);
+        sink.field("cache_hit_rate", res[c].cacheHitRate);
+        sink.field("seek_ms", res[c].seekTime);
+        sink.field("rotation_ms", res[c].rotationTime);
+        sink.field("transfer_ms", res[c].transferTime);
+        sink.field("track_switches", res[c].trackSwitches);
+        sink.field("missed_rotations", res[c].missedRotations);
+        sink.end();
     }
 }
 
 /*
-    int partitionBySector(&req, left, right)
+    void writePairedResults(&sink, alg, baseline, diff)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Quicksort partitioning through comparing Sector values of each I/O request.
+    date: Oct 16, 2026
+    description: Write one algorithm's paired differences against the baseline, one "paired"
+        record per test.
     parameters:
-        &req               I/P  vector<ioReq>  Vector of I/O requests to be sorted
-        left               I/P  int            Left most point of vector
-        right              I/P  int            Right most point of vector
-        partitionBySector  O/P  int            Identified pivot point
+        &sink     I/P  resultSink          Sink the records are written to
+        alg       I/P  char*               Algorithm name
+        baseline  I/P  char*               Baseline algorithm name
+        diff      I/P  vector<pairedDiff>  Paired differences for the algorithm
 */
-int partitionBySector(vector<ioReq> &req, int left, int right)
+void writePairedResults(resultSink &sink, const char *alg, const char *baseline, const vector<pairedDiff> &diff)
 {
-    ioReq temp;
-    int l = left, r = right;
-
-    int pivot = left + (right - left) / 2;
-    int pivotValue = req[pivot].sector;
+    for (int c = 0; c < (int)diff.size(); c++)
+    {
+        sink.begin("paired");
+        sink.field("alg", alg);
+        sink.field("baseline", baseline);
+        sink.field("test", c);
+        sink.field("requests", 50 + 10 * c);
+        sink.field("mean_diff_ms", diff[c].meanDiff);
+        sink.field("std_err_ms", diff[c].stdErr);
+        sink.end();
+    }
+}
 
-    while (l <= r)
+/*
+    void writeEventResults(&sink, cfg, res)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Write the discrete-event simulation results, one "events" record per algorithm.
+    parameters:
+        &sink  I/P  resultSink            Sink the records are written to
+        cfg    I/P  simConfig             Command line options
+        res    I/P  vector<eventResults>  Results in cfg.algs order
+*/
+void writeEventResults(resultSink &sink, const simConfig &cfg, const vector<eventResults> &res)
+{
+    for (int a = 0; a < (int)res.size(); a++)
     {
-        while (req[l].sector < pivotValue)
-            l++;
-        while (req[r].sector > pivotValue)
-            r--;
+        const eventResults &r = res[a];
+        sink.begin("events");
+        sink.field("alg", schedRegistry()[cfg.algs[a]].name);
+        sink.field("completed", r.completed);
+        sink.field("events", r.events);
+        sink.field("throughput_rps", r.throughput);
+        sink.field("mean_response_ms", r.meanResponse);
+        sink.field("mean_wait_ms", r.meanWait);
+        sink.field("p50_response_ms", r.response.p50);
+        sink.field("p90_response_ms", r.response.p90);
+        sink.field("p99_response_ms", r.response.p99);
+        sink.field("p999_response_ms", r.response.p999);
+        sink.field("max_response_ms", r.maxResponse);
+        sink.field("utilization", r.utilization);
+        sink.field("wall_s", r.wallSeconds);
+        sink.end();
+    }
+}
 
-        if (l <= r)
-        {
-            temp = req[l];
-            req[l] = req[r];
-            req[r] = temp;
-            l++;
-            r--;
-        }
+/*
+    void writeStreamResults(&sink, cfg, res)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Write the streaming results, one "stream" record per algorithm.
+    parameters:
+        &sink  I/P  resultSink             Sink the records are written to
+        cfg    I/P  simConfig              Command line options
+        res    I/P  vector<streamResults>  Results in cfg.algs order
+*/
+void writeStreamResults(resultSink &sink, const simConfig &cfg, const vector<streamResults> &res)
+{
+    for (int a = 0; a < (int)res.size(); a++)
+    {
+        const streamResults &r = res[a];
+        sink.begin("stream");
+        sink.field("alg", schedRegistry()[cfg.algs[a]].name);
+        sink.field("requests", r.requests);
+        sink.field("sim_time_ms", r.simTime);
+        sink.field("avg_seek_tracks", r.avgSeek);
+        sink.field("merged_requests", r.merged);
+        sink.field("cache_hits", r.cacheHits);
+        sink.field("p50_ms", r.latency.p50);
+        sink.field("p90_ms", r.latency.p90);
+        sink.field("p99_ms", r.latency.p99);
+        sink.field("p999_ms", r.latency.p999);
+        sink.field("max_ms", r.latency.max);
+        sink.field("wall_s", r.wallSeconds);
+        sink.end();
     }
-    return l;
 }
 
 /*
-    int partitionByTrack(&req, left, right)
+    void writeArrayResults(&sink, cfg, res)
     author: Gherkin
-    date: Nov 22, 2020
-    description: Quicksort partitioning through comparing Track values of each I/O request.
+    date: Oct 16, 2026
+    description: Write the disk array results, one "array" record per algorithm.
     parameters:
-        &req              I/P  vector<ioReq>  Vector of I/O requests to be sorted
-        left              I/P  int            Left most point of vector
-        right             I/P  int            Right most point of vector
-        partitionByTrack  O/P  int            Identified pivot point
+        &sink  I/P  resultSink            Sink the records are written to
+        cfg    I/P  simConfig             Command line options
+        res    I/P  vector<arrayResults>  Results in cfg.algs order
 */
-int partitionByTrack(vector<ioReq> &req, int left, int right)
+void writeArrayResults(resultSink &sink, const simConfig &cfg, const vector<arrayResults> &res)
 {
-    ioReq temp;
-    int l = left, r = right;
+    for (int a = 0; a < (int)res.size(); a++)
+    {
+        const arrayResults &r = res[a];
+        sink.begin("array");
+        sink.field("alg", schedRegistry()[cfg.algs[a]].name);
+        sink.field("requests", r.requests);
+        sink.field("drive_ios", r.ios);
+        sink.field("sim_time_ms", r.simTime);
+        sink.field("mean_drive_time_ms", r.meanDriveTime);
+        sink.field("avg_seek_tracks", r.avgSeek);
+        sink.field("merged_requests", r.merged);
+        sink.field("cache_hits", r.cacheHits);
+        sink.field("p50_ms", r.latency.p50);
+        sink.field("p90_ms", r.latency.p90);
+        sink.field("p99_ms", r.latency.p99);
+        sink.field("p999_ms", r.latency.p999);
+        sink.field("max_ms", r.latency.max);
+        sink.field("wall_s", r.wallSeconds);
+        sink.end();
+    }
+}
 
-    int pivot = left + (right - left) / 2;
-    int pivotValue = req[pivot].track;
+/*
+    void updateProgressBar(p, total, alg)
+    author: Gherkin
+    date: Nov 22, 2020
+    description: Print a graphical indicator of the current test's progression to stderr, unless
+        showProgress is off, so stdout only carries results. Plain ASCII, redrawn in place on a
+        terminal at most every PROGRESS_INTERVAL_MS; when stderr is a file or pipe only the
+        completion lines are written.
+    parameters:
+        p      I/P  int   Progression of execution loop
+        total  I/P  int   End point of loop
+        alg    I/P  char  Character representation of current algorithm (0 for a fused run)
 
-    while (l <= r)
+*/
+void updateProgressBar(int p, int total, char alg)
+{
+    if (!showProgress)
+        return;
+    static const bool terminal = isatty(fileno(stderr));
+    static std::chrono::steady_clock::time_point lastDraw;
+    float progress = (float)p / total;
+    if (progress == 1)
     {
-        while (req[l].track < pivotValue)
-            l++;
-        while (req[r].track > pivotValue)
-            r--;
-
-        if (l <= r)
-        {
-            temp = req[l];
-            req[l] = req[r];
-            req[r] = temp;
-            l++;
-            r--;
-        }
+        const char *pad = terminal ? "              " : ""; // clear what is left of the bar
+        if (alg == 0)
+            cerr << "All algorithms complete." << pad << "\n\n";
+        else
+            cerr << "Algorithm " << (char)toupper(alg) << " complete." << pad << "\n\n";
+        return;
     }
-    return l;
-}
\ No newline at end of file
+
+    // the bar is redrawn in place, so it is only drawn on a terminal and at most every
+    // PROGRESS_INTERVAL_MS; logs get the completion lines alone
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (!terminal || (p > 0 && now - lastDraw < std::chrono::milliseconds(PROGRESS_INTERVAL_MS)))
+        return;
+    lastDraw = now;
+
+    int barWidth = 30;
+    int pos = barWidth * progress;
+    char bar[32];
+    for (int i = 0; i < barWidth; ++i)
+        bar[i] = i <= pos ? '#' : '_';
+    bar[barWidth] = 0;
+    cerr << bar << " " << int(progress * 100.0) << " %\r";
+    cerr.flush();
+}
@@ -21,8 +21,7 @@ public:
     ioReq()
     author: Gherkin
     date: Nov 22, 2020
-    description: Basic constructor method that only exists because I needed to create a temp object
-        in my quicksort partition methods.
+    description: Basic constructor method; leaves the track and sector values unset.
 */
 ioReq::ioReq()
 {
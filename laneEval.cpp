@@ -0,0 +1,314 @@
+/*
+file: laneEval.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    laneServiceGroup - Service LANES interleaved experiments at once, one experiment per SIMD lane.
+    laneEvaluate - Generate, order and evaluate a run of experiments in lane groups.
+*/
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* Number of experiments evaluated side by side: one per 32-bit lane of the widest vector unit the
+   build targets. Without AVX2 the lanes are processed by a plain loop. */
+#if defined(__AVX512F__)
+#define LANES 16
+#else
+#define LANES 8
+#endif
+
+/* Statistics of every lane of a group at the end of laneServiceGroup */
+struct laneTotals
+{
+    float clock[LANES];         // Final clock
+    int seekSum[LANES];         // Tracks travelled
+    float seekTime[LANES];      // Time components, summed as serviceSequence sums them
+    float rotationTime[LANES];
+    float transferTime[LANES];
+    int trackSwitches[LANES];   // Steps that changed track
+    int missedRotations[LANES]; // Requests whose sector had just passed
+};
+
+/*
+    void laneServiceGroup(track, sector, steps, &totals, stepClock)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Service LANES experiments at once, one experiment per SIMD lane. The requests are
+        interleaved so that step i of lane l is at index i * LANES + l. Every lane performs exactly
+        the operations serviceRequest performs, in the same order, so each lane's clock, seek sum
+        and time components are bit-identical to servicing that experiment on its own. A sector of
+        -1 is a head move (see appendMove): the lane seeks but waits for no sector and transfers
+        nothing.
+    parameters:
+        track      I/P  int*        Interleaved track values, steps * LANES entries
+        sector     I/P  int*        Interleaved sector values, steps * LANES entries
+        steps      I/P  int         Number of requests serviced per lane
+        &totals    O/P  laneTotals  Final clock, seek sum and time components of each lane
+        stepClock  O/P  float*      Clock of each lane after each step, interleaved like track
+*/
+#if defined(__AVX512F__)
+void laneServiceGroup(const int *track, const int *sector, int steps, laneTotals &totals, float *stepClock)
+{
+    __m512i hTrack = _mm512_set1_epi32(START_HEAD.track);
+    __m512i hSector = _mm512_set1_epi32(START_HEAD.sector);
+    __m512 hClock = _mm512_set1_ps(START_HEAD.clock);
+    __m512i seeks = _mm512_setzero_si512();
+    __m512 seekTime = _mm512_setzero_ps(), rotationTime = _mm512_setzero_ps(), transferTime = _mm512_setzero_ps();
+    __m512i switches = _mm512_setzero_si512(), missed = _mm512_setzero_si512();
+
+    const __m512 rotFactor = _mm512_set1_ps(ROT_FACTOR);
+    const __m512 sectorsF = _mm512_set1_ps((float)SECTORS);
+    const __m512i sectors = _mm512_set1_epi32(SECTORS);
+    const __m512i lastSector = _mm512_set1_epi32(SECTORS - 1);
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512 transfer = _mm512_set1_ps(TRANSFER_MS);
+
+    for (int i = 0; i < steps; i++)
+    {
+        __m512i t = _mm512_loadu_si512(track + i * LANES);
+        __m512i s = _mm512_loadu_si512(sector + i * LANES);
+        __mmask16 serviced = _mm512_cmpge_epi32_mask(s, _mm512_setzero_si512());
+
+        // seek; SEEK_TABLE[0] is zero, so lanes that stay on their track add nothing
+        __m512i dist = _mm512_abs_epi32(_mm512_sub_epi32(t, hTrack));
+        __mmask16 moved = _mm512_cmpneq_epi32_mask(dist, _mm512_setzero_si512());
+        __m512 seek = _mm512_i32gather_ps(dist, SEEK_TABLE, 4);
+        hClock = _mm512_add_ps(hClock, seek);
+        seekTime = _mm512_add_ps(seekTime, seek);
+        seeks = _mm512_add_epi32(seeks, dist);
+        switches = _mm512_mask_add_epi32(switches, moved, switches, one);
+        hTrack = t;
+
+        // updateSector(clock) for the lanes that moved
+        __m512i spun = _mm512_cvttps_epi32(_mm512_mul_ps(hClock, rotFactor));
+        __m512i q = _mm512_cvttps_epi32(_mm512_div_ps(_mm512_cvtepi32_ps(spun), sectorsF));
+        spun = _mm512_sub_epi32(_mm512_sub_epi32(spun, _mm512_mullo_epi32(q, sectors)), one);
+        hSector = _mm512_mask_blend_epi32(moved, hSector, spun);
+
+        // rotational latency
+        __m512i diff = _mm512_sub_epi32(s, hSector);
+        __m512i wrap = _mm512_add_epi32(_mm512_sub_epi32(lastSector, hSector), s);
+        __mmask16 behind = _mm512_cmplt_epi32_mask(diff, _mm512_setzero_si512());
+        __m512i sectDiff = _mm512_maskz_mov_epi32(serviced, _mm512_mask_blend_epi32(behind, diff, wrap));
+        missed = _mm512_mask_add_epi32(missed, behind & serviced, missed, one);
+        hSector = _mm512_add_epi32(hSector, sectDiff);
+        hSector = _mm512_mask_sub_epi32(hSector, _mm512_cmpge_epi32_mask(hSector, sectors), hSector, sectors);
+        __m512 rotation = _mm512_i32gather_ps(sectDiff, ROT_TABLE, 4);
+        hClock = _mm512_add_ps(hClock, rotation);
+        rotationTime = _mm512_add_ps(rotationTime, rotation);
+
+        // transfer
+        hClock = _mm512_mask_add_ps(hClock, serviced, hClock, transfer);
+        transferTime = _mm512_mask_add_ps(transferTime, serviced, transferTime, transfer);
+        _mm512_storeu_ps(stepClock + i * LANES, hClock);
+    }
+
+    _mm512_storeu_ps(totals.clock, hClock);
+    _mm512_storeu_si512(totals.seekSum, seeks);
+    _mm512_storeu_ps(totals.seekTime, seekTime);
+    _mm512_storeu_ps(totals.rotationTime, rotationTime);
+    _mm512_storeu_ps(totals.transferTime, transferTime);
+    _mm512_storeu_si512(totals.trackSwitches, switches);
+    _mm512_storeu_si512(totals.missedRotations, missed);
+}
+#elif defined(__AVX2__)
+void laneServiceGroup(const int *track, const int *sector, int steps, laneTotals &totals, float *stepClock)
+{
+    __m256i hTrack = _mm256_set1_epi32(START_HEAD.track);
+    __m256i hSector = _mm256_set1_epi32(START_HEAD.sector);
+    __m256 hClock = _mm256_set1_ps(START_HEAD.clock);
+    __m256i seeks = _mm256_setzero_si256();
+    __m256 seekTime = _mm256_setzero_ps(), rotationTime = _mm256_setzero_ps(), transferTime = _mm256_setzero_ps();
+    __m256i switches = _mm256_setzero_si256(), missed = _mm256_setzero_si256();
+
+    const __m256 rotFactor = _mm256_set1_ps(ROT_FACTOR);
+    const __m256 sectorsF = _mm256_set1_ps((float)SECTORS);
+    const __m256i sectors = _mm256_set1_epi32(SECTORS);
+    const __m256i lastSector = _mm256_set1_epi32(SECTORS - 1);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 transfer = _mm256_set1_ps(TRANSFER_MS);
+
+    for (int i = 0; i < steps; i++)
+    {
+        __m256i t = _mm256_loadu_si256((const __m256i *)(track + i * LANES));
+        __m256i s = _mm256_loadu_si256((const __m256i *)(sector + i * LANES));
+        __m256i idle = _mm256_cmpgt_epi32(_mm256_setzero_si256(), s);
+
+        // seek; SEEK_TABLE[0] is zero, so lanes that stay on their track add nothing
+        __m256i dist = _mm256_abs_epi32(_mm256_sub_epi32(t, hTrack));
+        __m256i stayed = _mm256_cmpeq_epi32(dist, _mm256_setzero_si256());
+        __m256 seek = _mm256_i32gather_ps(SEEK_TABLE, dist, 4);
+        hClock = _mm256_add_ps(hClock, seek);
+        seekTime = _mm256_add_ps(seekTime, seek);
+        seeks = _mm256_add_epi32(seeks, dist);
+        switches = _mm256_add_epi32(switches, _mm256_andnot_si256(stayed, one));
+        hTrack = t;
+
+        // updateSector(clock) for the lanes that moved
+        __m256i spun = _mm256_cvttps_epi32(_mm256_mul_ps(hClock, rotFactor));
+        __m256i q = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(spun), sectorsF));
+        spun = _mm256_sub_epi32(_mm256_sub_epi32(spun, _mm256_mullo_epi32(q, sectors)), one);
+        hSector = _mm256_blendv_epi8(spun, hSector, stayed);
+
+        // rotational latency
+        __m256i diff = _mm256_sub_epi32(s, hSector);
+        __m256i wrap = _mm256_add_epi32(_mm256_sub_epi32(lastSector, hSector), s);
+        __m256i sectDiff = _mm256_castps_si256(
+            _mm256_blendv_ps(_mm256_castsi256_ps(diff), _mm256_castsi256_ps(wrap), _mm256_castsi256_ps(diff)));
+        sectDiff = _mm256_andnot_si256(idle, sectDiff);
+        // the sign bit of diff marks the lanes whose sector had passed; -1 for them, 0 for the others
+        missed = _mm256_sub_epi32(missed, _mm256_andnot_si256(idle, _mm256_srai_epi32(diff, 31)));
+        hSector = _mm256_add_epi32(hSector, sectDiff);
+        __m256i over = _mm256_cmpgt_epi32(hSector, lastSector);
+        hSector = _mm256_sub_epi32(hSector, _mm256_and_si256(over, sectors));
+        __m256 rotation = _mm256_i32gather_ps(ROT_TABLE, sectDiff, 4);
+        hClock = _mm256_add_ps(hClock, rotation);
+        rotationTime = _mm256_add_ps(rotationTime, rotation);
+
+        // transfer
+        __m256 transferred = _mm256_andnot_ps(_mm256_castsi256_ps(idle), transfer);
+        hClock = _mm256_add_ps(hClock, transferred);
+        transferTime = _mm256_add_ps(transferTime, transferred);
+        _mm256_storeu_ps(stepClock + i * LANES, hClock);
+    }
+
+    _mm256_storeu_ps(totals.clock, hClock);
+    _mm256_storeu_si256((__m256i *)totals.seekSum, seeks);
+    _mm256_storeu_ps(totals.seekTime, seekTime);
+    _mm256_storeu_ps(totals.rotationTime, rotationTime);
+    _mm256_storeu_ps(totals.transferTime, transferTime);
+    _mm256_storeu_si256((__m256i *)totals.trackSwitches, switches);
+    _mm256_storeu_si256((__m256i *)totals.missedRotations, missed);
+}
+#else
+void laneServiceGroup(const int *track, const int *sector, int steps, laneTotals &totals, float *stepClock)
+{
+    headState head[LANES];
+    for (int l = 0; l < LANES; l++)
+    {
+        head[l] = START_HEAD;
+        totals.seekSum[l] = 0;
+        totals.seekTime[l] = totals.rotationTime[l] = totals.transferTime[l] = 0;
+        totals.trackSwitches[l] = totals.missedRotations[l] = 0;
+    }
+
+    for (int i = 0; i < steps; i++)
+    {
+        for (int l = 0; l < LANES; l++)
+        {
+            int t = track[i * LANES + l];
+            int s = sector[i * LANES + l];
+            serviceCost c = {0, 0, 0, 0, false};
+            if (s < 0)
+            {
+                c.distance = moveHead(head[l], t);
+                c.seek = SEEK_TABLE[c.distance];
+            }
+            else
+                c = serviceRequest(head[l], t, s);
+            totals.seekSum[l] += c.distance;
+            totals.seekTime[l] += c.seek;
+            totals.rotationTime[l] += c.rotation;
+            totals.transferTime[l] += c.transfer;
+            totals.trackSwitches[l] += c.distance != 0;
+            totals.missedRotations[l] += c.missed;
+            stepClock[i * LANES + l] = head[l].clock;
+        }
+    }
+
+    for (int l = 0; l < LANES; l++)
+        totals.clock[l] = head[l].clock;
+}
+#endif
+
+/*
+    void laneEvaluate<Policy>(n, keys, count, out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Generate, order and evaluate a run of experiments in lane groups. Each experiment's
+        requests are laid into its lane in the order given by Policy::order and the group is serviced
+        by laneServiceGroup. Orders shorter than the longest possible one (n + Policy::extraSteps)
+        are padded with head moves that go nowhere, and a final partial group is padded by repeating
+        the last experiment. The statistics, and the latencies recorded into the thread's
+        latencySink, match Policy::run exactly. Only for fixed-order policies, on the built-in drive.
+    parameters:
+        Policy I/P  class           Scheduling policy with fixedOrder set (see schedPolicy.cpp)
+        n      I/P  int             Number of requests in every experiment
+        keys   I/P  experimentKey*  Experiments to evaluate
+        count  I/P  int             Number of experiments
+        out    O/P  hddSim*         Statistics of each experiment, in the same order as keys
+*/
+template <class Policy>
+void laneEvaluate(int n, const experimentKey *keys, int count, hddSim *out)
+{
+    static_assert(std::is_same<typename Policy::geometry, defaultGeometry>::value,
+                  "the lane kernels are written for the built-in drive's constants");
+    PROFILE_PHASE(PHASE_SCHEDULE);
+    reqPool &pool = threadReqPool();
+    pooledBatch gen(pool), sorted(pool), plan(pool), lanes(pool);
+    thread_local vector<float> stepClock;
+
+    const int steps = n + Policy::extraSteps;
+    lanes->resize(steps * LANES);
+    int *laneTrack = lanes->track.data();
+    int *laneSector = lanes->sector.data();
+    stepClock.resize(steps * LANES);
+    latencyHist *sink = latencySink;
+
+    laneTotals totals;
+    float fifoSeek[LANES];
+
+    for (int g = 0; g < count; g += LANES)
+    {
+        for (int l = 0; l < LANES; l++)
+        {
+            int e = min(g + l, count - 1);
+            generateRequests(n, keys[e], *gen);
+            fifoSeek[l] = sampling.control ? (float)fifoSeekControl(gen->span()) : 0;
+
+            reqSpan order = Policy::order(gen->span(), *sorted, *plan);
+            int k = 0;
+            for (; k < order.size; k++)
+            {
+                laneTrack[k * LANES + l] = order.track[k];
+                laneSector[k * LANES + l] = order.sector[k];
+            }
+            int last = k > 0 ? order.track[k - 1] : START_HEAD.track;
+            for (; k < steps; k++)
+            {
+                laneTrack[k * LANES + l] = last;
+                laneSector[k * LANES + l] = -1;
+            }
+        }
+
+        laneServiceGroup(laneTrack, laneSector, steps, totals, stepClock.data());
+
+        // record the completion time of every serviced request of the real (unpadded) lanes
+        if (sink)
+        {
+            const int used = min(LANES, count - g);
+            for (int k = 0; k < steps * LANES; k++)
+                if (laneSector[k] >= 0 && k % LANES < used)
+                    sink->record(stepClock[k]);
+        }
+
+        for (int l = 0; l < LANES && g + l < count; l++)
+        {
+            hddSim sim = newSim(n);
+            sim.avgSeekLength += totals.seekSum[l];
+            sim.totalTime = totals.clock[l];
+            sim.seekTime = totals.seekTime[l];
+            sim.rotationTime = totals.rotationTime[l];
+            sim.transferTime = totals.transferTime[l];
+            sim.trackSwitches = totals.trackSwitches[l];
+            sim.missedRotations = totals.missedRotations[l];
+            sim.fifoSeek = fifoSeek[l];
+            finishSim(sim);
+            out[g + l] = sim;
+        }
+    }
+}
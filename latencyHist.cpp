@@ -0,0 +1,214 @@
+/*
+file: latencyHist.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    latencyHist::clear - Empty the histogram.
+    latencyHist::record - Add a latency value, once or several times.
+    latencyHist::merge - Add the counts of another histogram.
+    latencyHist::percentile - Latency below which a given fraction of the recorded values fall.
+    latencyHist::summary - Percentiles and maximum of the recorded values.
+    latencyHist::save - Write the histogram to a file.
+    latencyHist::load - Read a histogram written by save.
+*/
+
+#include <cstdint>
+#include <cstdio>
+
+/* Bucket layout: every power of two between 2^HIST_MIN_EXP and 2^HIST_MAX_EXP ms is split into
+   2^HIST_SUB_BITS equal buckets, so a bucket is at most 1/128 (0.8 %) of its value wide. The bucket
+   index is read straight out of the float's exponent and top mantissa bits. */
+#define HIST_SUB_BITS 7
+#define HIST_MIN_EXP -10        // Values below ~1 us land in the first bucket
+#define HIST_MAX_EXP 24         // Values above ~4.6 h land in the last bucket
+#define HIST_BUCKETS ((HIST_MAX_EXP - HIST_MIN_EXP) << HIST_SUB_BITS)
+
+/* Tail latency of a set of requests, in milliseconds */
+struct latencySummary
+{
+    float p50;                  // Median
+    float p90;                  // 90th percentile
+    float p99;                  // 99th percentile
+    float p999;                 // 99.9th percentile
+    float max;                  // Largest recorded value (exact)
+};
+
+/* Fixed-memory log-bucketed histogram of latencies. Counts are integers, so merging histograms in
+   any order gives the same result. */
+class latencyHist
+{
+public:
+    latencyHist() { clear(); }
+    void clear();
+    inline void record(float ms, int times = 1);
+    void merge(const latencyHist &other);
+    float percentile(double p) const;
+    latencySummary summary() const;
+    long long count() const { return total; }
+    void save(FILE *out) const;
+    bool load(FILE *in);
+
+private:
+    uint64_t counts[HIST_BUCKETS];
+    long long total;
+    float maxValue;
+};
+
+/* Histogram the current thread records serviced requests into (see serviceSequence); null when
+   nothing is being recorded. Latencies are measured from latencyOrigin on the head clock. */
+thread_local latencyHist *latencySink = nullptr;
+thread_local float latencyOrigin = 0;
+
+/*
+    void clear()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Empty the histogram.
+*/
+void latencyHist::clear()
+{
+    std::fill(counts, counts + HIST_BUCKETS, 0);
+    total = 0;
+    maxValue = 0;
+}
+
+/*
+    void record(ms, times)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Add a latency value, once or, for requests that completed together, several times.
+        Positive floats order the same way as their bit patterns, so the bucket is the bit pattern
+        shifted down to the sub-bucket bits and rebased to HIST_MIN_EXP.
+    parameters:
+        ms     I/P  float  Latency in milliseconds
+        times  I/P  int    Number of requests with that latency (1 by default)
+*/
+inline void latencyHist::record(float ms, int times)
+{
+    uint32_t bits;
+    memcpy(&bits, &ms, sizeof bits);
+    int b = (int)(bits >> (23 - HIST_SUB_BITS)) - ((127 + HIST_MIN_EXP) << HIST_SUB_BITS);
+    b = b < 0 ? 0 : (b >= HIST_BUCKETS ? HIST_BUCKETS - 1 : b);
+    counts[b] += times;
+    total += times;
+    maxValue = ms > maxValue ? ms : maxValue;
+}
+
+/*
+    void merge(other)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Add the counts of another histogram.
+    parameters:
+        other  I/P  latencyHist  Histogram to add
+*/
+void latencyHist::merge(const latencyHist &other)
+{
+    for (int b = 0; b < HIST_BUCKETS; b++)
+        counts[b] += other.counts[b];
+    total += other.total;
+    maxValue = other.maxValue > maxValue ? other.maxValue : maxValue;
+}
+
+/*
+    float percentile(p)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Latency below which a fraction p of the recorded values fall, reported as the upper
+        edge of the bucket holding that value (never above the recorded maximum).
+    parameters:
+        p           I/P  double  Fraction between 0 and 1
+        percentile  O/P  float   Latency in milliseconds; 0 if nothing was recorded
+*/
+float latencyHist::percentile(double p) const
+{
+    if (total == 0)
+        return 0;
+    long long rank = (long long)ceil(p * total);
+    rank = rank < 1 ? 1 : rank;
+    long long seen = 0;
+    for (int b = 0; b < HIST_BUCKETS; b++)
+    {
+        seen += counts[b];
+        if (seen >= rank)
+        {
+            uint32_t bits = (uint32_t)(b + 1 + ((127 + HIST_MIN_EXP) << HIST_SUB_BITS)) << (23 - HIST_SUB_BITS);
+            float upper;
+            memcpy(&upper, &bits, sizeof upper);
+            return upper < maxValue ? upper : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+/*
+    latencySummary summary()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Percentiles and maximum of the recorded values.
+    parameters:
+        summary  O/P  latencySummary  p50, p90, p99, p99.9 and max in milliseconds
+*/
+latencySummary latencyHist::summary() const
+{
+    latencySummary s;
+    s.p50 = percentile(0.5);
+    s.p90 = percentile(0.9);
+    s.p99 = percentile(0.99);
+    s.p999 = percentile(0.999);
+    s.max = maxValue;
+    return s;
+}
+
+/*
+    void save(out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Write the histogram to a file in native byte order: the count, the maximum, the
+        number of non-empty buckets and then each as a (u32 bucket, u64 count) pair.
+    parameters:
+        out  I/P  FILE*  File to write to
+*/
+void latencyHist::save(FILE *out) const
+{
+    uint32_t used = 0;
+    for (int b = 0; b < HIST_BUCKETS; b++)
+        used += counts[b] != 0;
+    fwrite(&total, sizeof total, 1, out);
+    fwrite(&maxValue, sizeof maxValue, 1, out);
+    fwrite(&used, sizeof used, 1, out);
+    for (uint32_t b = 0; b < HIST_BUCKETS; b++)
+    {
+        if (counts[b] == 0)
+            continue;
+        fwrite(&b, sizeof b, 1, out);
+        fwrite(&counts[b], sizeof counts[b], 1, out);
+    }
+}
+
+/*
+    bool load(in)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Read a histogram written by save, replacing the contents.
+    parameters:
+        in    I/P  FILE*  File to read from
+        load  O/P  bool   False if the file ended early or names a bucket out of range
+*/
+bool latencyHist::load(FILE *in)
+{
+    clear();
+    uint32_t used;
+    if (fread(&total, sizeof total, 1, in) != 1 || fread(&maxValue, sizeof maxValue, 1, in) != 1 ||
+        fread(&used, sizeof used, 1, in) != 1)
+        return false;
+    for (uint32_t k = 0; k < used; k++)
+    {
+        uint32_t b;
+        if (fread(&b, sizeof b, 1, in) != 1 || b >= HIST_BUCKETS || fread(&counts[b], sizeof counts[b], 1, in) != 1)
+            return false;
+    }
+    return true;
+}
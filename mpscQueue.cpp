@@ -0,0 +1,122 @@
+/*
+file: mpscQueue.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    mpscQueue - Constructor method that allocates the ring.
+    mpscQueue::push - Add a value from any thread.
+    mpscQueue::pop - Take the oldest value, on the consumer thread.
+*/
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+/* Bounded lock-free multi-producer, single-consumer queue on a ring of slots (D. Vyukov's bounded
+   queue with the consumer side simplified). Each slot carries a sequence number saying whose turn
+   it is: a producer claims position p with one compare-and-swap on the shared tail once slot
+   p mod size reads p, writes its value and publishes it by setting the sequence to p + 1; the
+   consumer takes position p once the sequence reads p + 1 and hands the slot to the next lap by
+   setting it to p + size. Producers never wait for each other beyond a failed CAS and the consumer
+   never writes shared counters, so neither side takes a lock or allocates. A producer that stops
+   between claiming and publishing holds up the consumer at that slot until it carries on. The tail
+   and the consumer's position sit on cache lines of their own. */
+template <class T>
+class mpscQueue
+{
+public:
+    explicit mpscQueue(int capacity);
+    bool push(const T &value);
+    bool pop(T &value);
+    size_t capacity() const { return mask + 1; }
+
+private:
+    struct slot
+    {
+        std::atomic<uint64_t> sequence;         // Position that may use the slot next (see above)
+        T value;
+    };
+
+    std::unique_ptr<slot[]> slots;
+    size_t mask;                                // Slots - 1; the slot count is a power of two
+    alignas(64) std::atomic<uint64_t> tail;     // Next position a producer claims
+    alignas(64) uint64_t head;                  // Next position the consumer takes
+};
+
+/*
+    mpscQueue(capacity)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that allocates the ring, rounding the capacity up to a power
+        of two so a position maps onto its slot with a mask.
+    parameters:
+        capacity  I/P  int  Fewest values the queue holds before push refuses more
+*/
+template <class T>
+mpscQueue<T>::mpscQueue(int capacity) : tail(0), head(0)
+{
+    size_t size = 2;
+    while (size < (size_t)capacity)
+        size <<= 1;
+    slots.reset(new slot[size]);
+    for (size_t s = 0; s < size; s++)
+        slots[s].sequence.store(s, std::memory_order_relaxed);
+    mask = size - 1;
+}
+
+/*
+    bool push(value)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Add a value to the queue. Safe to call from any number of threads at once.
+    parameters:
+        value  I/P  T     Value to add
+        push   O/P  bool  False if the queue was full; the value was not added
+*/
+template <class T>
+bool mpscQueue<T>::push(const T &value)
+{
+    uint64_t pos = tail.load(std::memory_order_relaxed);
+    slot *s;
+    for (;;)
+    {
+        s = &slots[pos & mask];
+        const int64_t lag = (int64_t)(s->sequence.load(std::memory_order_acquire) - pos);
+        if (lag == 0)
+        {
+            // the slot is free on this lap; claim the position unless another producer got it first
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (lag < 0)
+            return false;   // the consumer has not yet taken the value a lap behind
+        else
+            pos = tail.load(std::memory_order_relaxed);
+    }
+    s->value = value;
+    s->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/*
+    bool pop(&value)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Take the oldest published value. Only one thread, the consumer, may call it.
+    parameters:
+        &value  O/P  T     Value taken
+        pop     O/P  bool  False if no value was ready
+*/
+template <class T>
+bool mpscQueue<T>::pop(T &value)
+{
+    slot &s = slots[head & mask];
+    if (s.sequence.load(std::memory_order_acquire) != head + 1)
+        return false;
+    value = s.value;
+    s.sequence.store(head + mask + 1, std::memory_order_release);
+    head++;
+    return true;
+}
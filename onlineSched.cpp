@@ -0,0 +1,255 @@
+/*
+file: onlineSched.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    onlineScheduler - Constructor method that creates an empty scheduler.
+    onlineScheduler::submit - Hand a request to the scheduler from any thread.
+    onlineScheduler::next - Take the request the policy would service next.
+    onlineStress - Drive one scheduler with several producer threads and a dispatcher.
+*/
+
+/* One request going through an onlineScheduler */
+struct onlineReq
+{
+    int track;                  // Track value of the request
+    int sector;                 // Sector value of the request; -1 for a head move from next
+    uint64_t tag;               // Caller's handle, returned unchanged by next
+};
+
+/* Incremental form of a scheduling policy, for driving it from a live request stream instead of a
+   batch: any thread submits requests as they come up, and one dispatcher thread asks for the next
+   one to service each time the drive is free, passing the head's position. Submissions land in a
+   lock-free MPSC ring (see mpscQueue.cpp) and next moves them from it into the policy's own
+   pending set (Policy::queue, the event simulation's), which keeps them ordered for its picks.
+   Both are bounded: the ring holds capacity requests and the pending set at most depth, so a full
+   scheduler pushes back on the producers, and a policy that can pass requests over (SSTF, LIFO)
+   only chooses among the depth admitted first. Requests are admitted in ring order, which numbers
+   them as their arrival for the policies that break ties on it. */
+template <class Policy>
+class onlineScheduler
+{
+public:
+    onlineScheduler(int capacity, int depth);
+    bool submit(int track, int sector, uint64_t tag) { return inbox.push(onlineReq{track, sector, tag}); }
+    bool next(const headState &head, onlineReq &out);
+    int pending() const { return held; }
+
+private:
+    mpscQueue<onlineReq> inbox; // Submitted requests not yet admitted
+    typename Policy::queue index; // Admitted requests, in the policy's order
+    int depth;                  // Most requests admitted at once
+    int held;                   // Requests admitted and not yet taken
+    double admitted;            // Requests admitted so far, the arrival of the next one
+};
+
+/* Settings of an online stress run */
+struct onlineConfig
+{
+    int producers;              // Threads submitting requests
+    long long requests;         // Requests submitted in all, shared evenly between the producers
+    unsigned seed;              // Randomization seed of the requests
+    int capacity;               // Requests the submission ring holds
+    int depth;                  // Requests the policy chooses among at once
+};
+
+/* Statistics from one online stress run */
+struct onlineResults
+{
+    long long requests;         // Requests submitted and dispatched
+    double submitNs;            // Mean producer time per submit in ns, waits on a full ring included
+    double submitRate;          // Requests submitted per second, all producers together
+    double dispatchRate;        // Requests dispatched per second
+    long long fullRetries;      // Submits refused because the ring was full, and retried
+    double avgSeek;             // Mean tracks crossed per request
+    double simTime;             // Simulated time to service every request in ms
+    latencySummary latency;     // Real time from submit to dispatch in ms
+    double wallSeconds;         // Real time the run took
+};
+
+/* Requests a producer draws ahead of submitting them */
+#define ONLINE_DRAW 1024
+
+/*
+    uint64_t onlineNow()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Current steady_clock time in nanoseconds, the tag onlineStress submits with.
+    parameters:
+        onlineNow  O/P  uint64_t  Nanoseconds since the clock's epoch
+*/
+inline uint64_t onlineNow()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+    onlineScheduler<Policy>(capacity, depth)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that creates an empty scheduler.
+    parameters:
+        Policy    I/P  class  Scheduling policy (see schedPolicy.cpp)
+        capacity  I/P  int    Submitted requests held before submit refuses more (rounded up to a power of two)
+        depth     I/P  int    Most requests the policy chooses among at once
+*/
+template <class Policy>
+onlineScheduler<Policy>::onlineScheduler(int capacity, int depth)
+    : inbox(capacity), index(Policy::makeQueue()), depth(max(1, depth)), held(0), admitted(0)
+{
+}
+
+/*
+    bool next(head, &out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Take the request the policy would service next with the head where it is. Waiting
+        submissions are admitted first, while fewer than depth are pending. A sweep that runs on to
+        the disk edge asks for a head move first: out then has sector -1 and the track to seek to,
+        and next is called again once the head is there. Only one thread may call it.
+    parameters:
+        head  I/P  headState  Head position and clock
+        &out  O/P  onlineReq  Request to service, or head move to make
+        next  O/P  bool       False if nothing was pending; out is unchanged
+*/
+template <class Policy>
+bool onlineScheduler<Policy>::next(const headState &head, onlineReq &out)
+{
+    onlineReq r;
+    while (held < depth && inbox.pop(r))
+    {
+        index.add(timedReq{admitted++, r.track, r.sector, r.tag});
+        held++;
+    }
+    if (held == 0)
+        return false;
+
+    const int d = index.detour(head);
+    if (d >= 0)
+    {
+        out = onlineReq{d, -1, 0};
+        return true;
+    }
+    const timedReq t = index.pick(head);
+    held--;
+    out = onlineReq{t.track, t.sector, t.tag};
+    return true;
+}
+
+/*
+    onlineResults onlineStress<Policy>(cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Drive one scheduler with several producer threads and a dispatcher. Each producer
+        submits its share of the requests (drawn with drawRequests as the experiment
+        (cfg.seed, STREAM_ONLINE, 0)) as fast as the scheduler takes them, yielding and retrying
+        while the ring is full; the tag is the submit time. The calling thread dispatches: it takes
+        requests with next, services them with serviceRequest so the head moves as it would on the
+        drive, and records each request's time from submit to dispatch. The producers start
+        together once they are all running. The order requests reach the scheduler in depends on
+        the thread interleaving, so the simulated figures vary a little from run to run.
+    parameters:
+        Policy        I/P  class          Scheduling policy (see schedPolicy.cpp)
+        cfg           I/P  onlineConfig   Producers, request count, seed and scheduler bounds
+        onlineStress  O/P  onlineResults  Submit and dispatch rates and latencies
+*/
+template <class Policy>
+onlineResults onlineStress(const onlineConfig &cfg)
+{
+    std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+    onlineScheduler<Policy> sched(cfg.capacity, cfg.depth);
+    const experimentKey key{cfg.seed, STREAM_ONLINE, 0};
+    const int producers = max(1, cfg.producers);
+
+    std::atomic<int> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<uint64_t> submitTime(producers), finished(producers);
+    std::vector<long long> retries(producers);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+        threads.emplace_back([&, p]() {
+            const long long first = cfg.requests * p / producers, last = cfg.requests * (p + 1) / producers;
+            int track[ONLINE_DRAW], sector[ONLINE_DRAW];
+            uint64_t spent = 0;
+            long long refused = 0;
+            ready++;
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            for (long long b = first; b < last; b += ONLINE_DRAW)
+            {
+                const int count = (int)min((long long)ONLINE_DRAW, last - b);
+                drawRequests(key, (uint32_t)cfg.requests, b, count, track, sector);
+                const uint64_t start = onlineNow();
+                for (int k = 0; k < count; k++)
+                    while (!sched.submit(track[k], sector[k], onlineNow()))
+                    {
+                        refused++;
+                        std::this_thread::yield();
+                    }
+                spent += onlineNow() - start;
+            }
+            submitTime[p] = spent;
+            retries[p] = refused;
+            finished[p] = onlineNow();
+        });
+    while (ready.load() < producers)
+        std::this_thread::yield();
+
+    onlineResults res;
+    latencyHist latency;
+    headState head = startHead();
+    double simMs = 0;
+    long long seeks = 0, done = 0;
+    const uint64_t start = onlineNow();
+    go.store(true, std::memory_order_release);
+    {
+        PROFILE_PHASE(PHASE_SCHEDULE);
+        onlineReq r;
+        while (done < cfg.requests)
+        {
+            head.clock = (float)fmod(simMs, drive.rotationPeriod);
+            if (!sched.next(head, r))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            const uint64_t now = onlineNow();
+            if (r.sector < 0)
+            {
+                const int distance = moveHead(head, r.track);
+                seeks += distance;
+                simMs += drive.seekTable[distance];
+                continue;
+            }
+            serviceCost c = serviceRequest(head, r.track, r.sector);
+            simMs += c.seek + c.rotation + c.transfer;
+            seeks += c.distance;
+            latency.record((float)((now - r.tag) * 1e-6));
+            done++;
+        }
+    }
+    const uint64_t end = onlineNow();
+    for (std::thread &t : threads)
+        t.join();
+
+    uint64_t spent = 0, lastSubmit = start;
+    res.fullRetries = 0;
+    for (int p = 0; p < producers; p++)
+    {
+        spent += submitTime[p];
+        lastSubmit = max(lastSubmit, finished[p]);
+        res.fullRetries += retries[p];
+    }
+    res.requests = cfg.requests;
+    res.submitNs = cfg.requests > 0 ? (double)spent / cfg.requests : 0;
+    res.submitRate = lastSubmit > start ? cfg.requests * 1e9 / (lastSubmit - start) : 0;
+    res.dispatchRate = end > start ? cfg.requests * 1e9 / (end - start) : 0;
+    res.avgSeek = cfg.requests > 0 ? (double)seeks / cfg.requests : 0;
+    res.simTime = simMs;
+    res.latency = latency.summary();
+    res.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return res;
+}
@@ -0,0 +1,179 @@
+/*
+file: reqBatch.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    reqSpan::at - Copy one request out of a non-owning request view.
+    reqBatch::resize - Set the number of requests held, keeping the allocated storage.
+    reqBatch::push_back - Append one request to the batch.
+    reqBatch::assign - Replace the batch contents with a copy of a request view.
+    reqPool::acquire - Take a batch out of the pool, allocating one only if the pool is empty.
+    reqPool::release - Return a batch to the pool so its storage can be reused.
+    threadReqPool - The calling thread's own request pool.
+*/
+
+#include <vector>
+#include <memory>
+
+/* Non-owning view of a batch of requests. Tracks and sectors are stored in separate arrays. */
+struct reqSpan
+{
+    const int *track;           // Track value of each request
+    const int *sector;          // Sector value of each request
+    int size;                   // Number of requests
+
+    ioReq at(int i) const;
+};
+
+/* Owning batch of requests, stored as separate contiguous track and sector arrays */
+class reqBatch
+{
+public:
+    std::vector<int> track, sector;
+
+    int size() const { return (int)track.size(); }
+    void clear() { track.clear(); sector.clear(); }
+    void resize(int n);
+    void push_back(int t, int s);
+    void assign(reqSpan req);
+    reqSpan span() const { return reqSpan{track.data(), sector.data(), size()}; }
+};
+
+/* Pool of request batches that keeps their storage alive between experiments */
+class reqPool
+{
+public:
+    reqBatch *acquire();
+    void release(reqBatch *b);
+
+private:
+    std::vector<std::unique_ptr<reqBatch>> owned;
+    std::vector<reqBatch *> spare;
+};
+
+/* Batch borrowed from a pool for the current scope */
+class pooledBatch
+{
+public:
+    pooledBatch(reqPool &p) : pool(p), b(p.acquire()) {}
+    ~pooledBatch() { pool.release(b); }
+    pooledBatch(const pooledBatch &) = delete;
+    pooledBatch &operator=(const pooledBatch &) = delete;
+
+    reqBatch &operator*() { return *b; }
+    reqBatch *operator->() { return b; }
+
+private:
+    reqPool &pool;
+    reqBatch *b;
+};
+
+/*
+    ioReq at(i)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Copy one request out of a non-owning request view.
+    parameters:
+        i   I/P  int    Index of the request
+        at  O/P  ioReq  The request at index i
+*/
+ioReq reqSpan::at(int i) const
+{
+    return ioReq(track[i], sector[i]);
+}
+
+/*
+    void resize(n)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Set the number of requests held. Shrinking never frees storage, so a batch that is
+        refilled with the same or a smaller number of requests does not touch the heap.
+    parameters:
+        n  I/P  int  New number of requests
+*/
+void reqBatch::resize(int n)
+{
+    track.resize(n);
+    sector.resize(n);
+}
+
+/*
+    void push_back(t, s)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Append one request to the batch.
+    parameters:
+        t  I/P  int  Track value of I/O request
+        s  I/P  int  Sector value of I/O request
+*/
+void reqBatch::push_back(int t, int s)
+{
+    track.push_back(t);
+    sector.push_back(s);
+}
+
+/*
+    void assign(req)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Replace the batch contents with a copy of a request view.
+    parameters:
+        req  I/P  reqSpan  Requests to copy
+*/
+void reqBatch::assign(reqSpan req)
+{
+    track.assign(req.track, req.track + req.size);
+    sector.assign(req.sector, req.sector + req.size);
+}
+
+/*
+    reqBatch *acquire()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Take an empty batch out of the pool, allocating one only if the pool is empty.
+        The batch keeps whatever capacity it had when it was released.
+    parameters:
+        acquire  O/P  reqBatch*  Empty batch owned by the pool
+*/
+reqBatch *reqPool::acquire()
+{
+    if (spare.empty())
+    {
+        owned.push_back(std::unique_ptr<reqBatch>(new reqBatch()));
+        spare.reserve(owned.size());
+        return owned.back().get();
+    }
+    reqBatch *b = spare.back();
+    spare.pop_back();
+    b->clear();
+    return b;
+}
+
+/*
+    void release(b)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Return a batch to the pool so its storage can be reused.
+    parameters:
+        b  I/P  reqBatch*  Batch previously returned by acquire()
+*/
+void reqPool::release(reqBatch *b)
+{
+    spare.push_back(b);
+}
+
+/*
+    reqPool &threadReqPool()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: The calling thread's own request pool. Pools are never shared, so no locking is needed.
+    parameters:
+        threadReqPool  O/P  reqPool&  Pool belonging to the calling thread
+*/
+reqPool &threadReqPool()
+{
+    thread_local reqPool pool;
+    return pool;
+}
@@ -0,0 +1,198 @@
+/*
+file: reqMerge.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    reqMerger::merge - Coalesce the requests of a batch into multi-block requests.
+    reqMerger::extent - Blocks and original requests of a merged request.
+*/
+
+/* Settings of the request merging stage (--coalesce); maxBlocks is 0 when every request is
+   serviced on its own */
+struct mergeConfig
+{
+    int maxBlocks;              // Most blocks one merged request may transfer
+};
+
+mergeConfig mergeSettings = {0};
+
+/* Elevator-style request merging, run on a batch before it reaches the scheduler. A request on the
+   sector just past a queued request's end is back-merged into it, one on the sector just before
+   its start is front-merged, and one on a sector it already covers is absorbed; a merged request
+   keeps the earliest arrival position of its members, stays on one track and transfers at most
+   mergeSettings.maxBlocks blocks. The whole batch is queued at once, so every merge is found by
+   sorting it on (track, sector) and walking the sorted index: contiguous neighbours are adjacent
+   in it. Schedulers only see (track, first sector) of a merged request; its length is kept in a
+   small open-addressed table that serviceSequence reads, holding only requests that did merge. */
+class reqMerger
+{
+public:
+    void merge(reqSpan in, reqBatch &out);
+    inline int extent(int track, int sector, int &members) const;
+    int absorbed() const { return lastAbsorbed; }
+
+private:
+    struct pending
+    {
+        uint64_t key;           // Track in the high word, sector in the low word
+        int index;              // Arrival position in the batch
+    };
+    struct extentSlot
+    {
+        uint64_t key;           // Start of a merged request, EXTENT_EMPTY for a free slot
+        int blocks;             // Blocks it transfers
+        int members;            // Original requests merged into it
+    };
+    static constexpr uint64_t EXTENT_EMPTY = ~(uint64_t)0;
+
+    static uint64_t keyOf(int track, int sector) { return (uint64_t)track << 32 | (uint32_t)sector; }
+    size_t slotOf(uint64_t key) const { return (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift); }
+
+    vector<pending> sorted;     // The batch sorted on (key, index)
+    vector<int> bySector;       // Arrival positions sorted on sector, the counting sort's first pass
+    vector<int> position;       // Counting sort offsets per sector, then per track
+    vector<uint64_t> startOf;   // Start key of the merged request each arrival leads, EXTENT_EMPTY if none
+    vector<extentSlot> slots;   // Lengths of the merged requests with more than one member
+    int shift = 63;             // 64 - log2(slots.size())
+    int lastAbsorbed = 0;       // Requests the last merge folded into another
+};
+
+constexpr uint64_t reqMerger::EXTENT_EMPTY;
+
+/* Merger of the requests the current thread services (see serviceSequence); null when requests are
+   serviced one block at a time */
+thread_local reqMerger *activeMerger = nullptr;
+
+/*
+    void merge(in, &out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Coalesce the requests of a batch into multi-block requests. The batch is sorted on
+        (track, sector, arrival), in linear time like sortRequests (with the same fallback for a
+        batch that is tiny next to the drive), and walked once: a run takes the following requests
+        while they are on its track and either repeat its last sector or extend it by one, up to
+        mergeSettings.maxBlocks blocks. Each run comes out once, as (track, first sector), at the
+        place of its earliest member, so FIFO and LIFO still see the arrival order. The lengths of
+        the runs that merged anything replace those of the previous batch in the extent table.
+    parameters:
+        in    I/P  reqSpan   Requests in arrival order
+        &out  O/P  reqBatch  Merged requests in arrival order of their first member; overwritten
+*/
+void reqMerger::merge(reqSpan in, reqBatch &out)
+{
+    const int n = in.size;
+    sorted.resize(n);
+    if ((long long)n * KEY_SORT_SPARSITY < drive.tracks)
+    {
+        for (int i = 0; i < n; i++)
+            sorted[i] = pending{keyOf(in.track[i], in.sector[i]), i};
+        std::sort(sorted.begin(), sorted.end(), [](const pending &a, const pending &b) {
+            return a.key < b.key || (a.key == b.key && a.index < b.index);
+        });
+    }
+    else
+    {
+        // stable counting sorts of the arrival positions, on sector then on track, as in sortRequests
+        bySector.resize(n);
+        position.assign(drive.maxSectors, 0);
+        for (int i = 0; i < n; i++)
+            position[in.sector[i]]++;
+        for (int v = 0, sum = 0; v < drive.maxSectors; v++)
+        {
+            int c = position[v];
+            position[v] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < n; i++)
+            bySector[position[in.sector[i]]++] = i;
+
+        position.assign(drive.tracks, 0);
+        for (int i = 0; i < n; i++)
+            position[in.track[i]]++;
+        for (int v = 0, sum = 0; v < drive.tracks; v++)
+        {
+            int c = position[v];
+            position[v] = sum;
+            sum += c;
+        }
+        for (int k = 0; k < n; k++)
+        {
+            const int i = bySector[k];
+            sorted[position[in.track[i]]++] = pending{keyOf(in.track[i], in.sector[i]), i};
+        }
+    }
+
+    // the table keeps at least half its slots free, so every probe sequence ends on an empty one
+    size_t size = 2;
+    while (size < 2 * (size_t)n)
+        size <<= 1;
+    slots.assign(size, extentSlot{EXTENT_EMPTY, 1, 1});
+    shift = 64 - __builtin_ctzll(size);
+
+    startOf.assign(n, EXTENT_EMPTY);
+    int runs = 0;
+    for (int k = 0; k < n;)
+    {
+        // no request sits past the end of a track, so start + blocks never reaches the next one
+        const uint64_t start = sorted[k].key;
+        int blocks = 1, members = 1, first = sorted[k].index;
+        int j = k + 1;
+        for (; j < n; j++)
+        {
+            const uint64_t key = sorted[j].key;
+            if (key == start + blocks && blocks < mergeSettings.maxBlocks)
+                blocks++;
+            else if (key != start + blocks - 1)
+                break;
+            members++;
+            first = min(first, sorted[j].index);
+        }
+        startOf[first] = start;
+        if (members > 1)
+        {
+            size_t s = slotOf(start);
+            while (slots[s].key != EXTENT_EMPTY)
+                s = (s + 1) & (size - 1);
+            slots[s] = extentSlot{start, blocks, members};
+        }
+        runs++;
+        k = j;
+    }
+
+    out.resize(runs);
+    int m = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (startOf[i] == EXTENT_EMPTY)
+            continue;
+        out.track[m] = (int)(startOf[i] >> 32);
+        out.sector[m] = (int)(uint32_t)startOf[i];
+        m++;
+    }
+    lastAbsorbed = n - runs;
+}
+
+/*
+    int extent(track, sector, &members)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Blocks and original requests of a request of the last merged batch, found by
+        probing the extent table from the start's hash. A request that did not merge with
+        anything is not in the table and is one block for one request.
+    parameters:
+        track     I/P  int  Track of the merged request
+        sector    I/P  int  First sector of the merged request
+        &members  O/P  int  Original requests it stands for
+        extent    O/P  int  Blocks it transfers
+*/
+inline int reqMerger::extent(int track, int sector, int &members) const
+{
+    const uint64_t key = keyOf(track, sector);
+    size_t s = slotOf(key);
+    while (slots[s].key != key && slots[s].key != EXTENT_EMPTY)
+        s = (s + 1) & (slots.size() - 1);
+    members = slots[s].members;
+    return slots[s].blocks;
+}
@@ -0,0 +1,182 @@
+/*
+file: reqSort.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    sortRequests - Sort requests by track, then by sector, in linear time.
+    keySortRequests - Sort a batch that is small next to the drive by packed (track, sector) keys.
+    parallelSortRequests - Sort a very large batch of requests on a thread pool.
+*/
+
+/* Batches at least this large are sorted by parallelSortRequests */
+#define PARALLEL_SORT_MIN (1 << 20)
+/* Batches with fewer than one request per this many tracks are sorted by keySortRequests, as
+   clearing the counting sort's per-track counts would cost more than the sort itself */
+#define KEY_SORT_SPARSITY 16
+
+void keySortRequests(reqSpan in, reqBatch &out);
+void parallelSortRequests(reqSpan in, reqBatch &out, threadPool &pool);
+
+/* Pool the current thread may spread a large sort over, set by a driver for the pool it owns (the
+   -t threads); null sorts on the calling thread alone. A sort started inside one of the pool's
+   chunks is always serial, so sorts never oversubscribe the pool or post to it while it is busy. */
+thread_local threadPool *sortPool = nullptr;
+
+/*
+    void sortRequests(in, &out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Sort requests by track, then by sector, in linear time. Track and sector values are
+        small bounded keys, so this is a two-pass LSD counting sort: a stable pass on sector into a
+        pooled scratch batch, then a stable pass on track into out. Requests with equal track and
+        sector keep their original order. Batches that are tiny next to a large drive are handed to
+        keySortRequests, very large ones to parallelSortRequests when the thread has an idle sortPool.
+    parameters:
+        in    I/P  reqSpan   View of I/O requests to be sorted
+        &out  O/P  reqBatch  Sorted requests; resized to in.size
+*/
+void sortRequests(reqSpan in, reqBatch &out)
+{
+    PROFILE_PHASE(PHASE_SORT);
+    const int n = in.size;
+    out.resize(n);
+    if ((long long)n * KEY_SORT_SPARSITY < drive.tracks)
+    {
+        keySortRequests(in, out);
+        return;
+    }
+    if (n >= PARALLEL_SORT_MIN && sortPool != nullptr && sortPool->size() > 1 && !threadPool::inChunk())
+    {
+        parallelSortRequests(in, out, *sortPool);
+        return;
+    }
+
+    pooledBatch scratch(threadReqPool());
+    scratch->resize(n);
+    int *tmpTrack = scratch->track.data();
+    int *tmpSector = scratch->sector.data();
+
+    // pass 1: stable counting sort on sector into the scratch batch
+    thread_local std::vector<int> sectorPos, trackPos;
+    sectorPos.assign(drive.maxSectors, 0);
+    for (int i = 0; i < n; i++)
+        sectorPos[in.sector[i]]++;
+    for (int s = 0, sum = 0; s < drive.maxSectors; s++)
+    {
+        int c = sectorPos[s];
+        sectorPos[s] = sum;
+        sum += c;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        int pos = sectorPos[in.sector[i]]++;
+        tmpTrack[pos] = in.track[i];
+        tmpSector[pos] = in.sector[i];
+    }
+
+    // pass 2: stable counting sort on track into out
+    trackPos.assign(drive.tracks, 0);
+    for (int i = 0; i < n; i++)
+        trackPos[tmpTrack[i]]++;
+    for (int t = 0, sum = 0; t < drive.tracks; t++)
+    {
+        int c = trackPos[t];
+        trackPos[t] = sum;
+        sum += c;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        int pos = trackPos[tmpTrack[i]]++;
+        out.track[pos] = tmpTrack[i];
+        out.sector[pos] = tmpSector[i];
+    }
+}
+
+/*
+    void keySortRequests(in, &out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Sort a batch that is small next to the drive by packing each request into one
+        (track, sector) key and sorting the keys. Requests with equal keys are identical, so the
+        result is the same order sortRequests produces.
+    parameters:
+        in    I/P  reqSpan   View of I/O requests to be sorted
+        &out  O/P  reqBatch  Sorted requests; must already hold in.size entries
+*/
+void keySortRequests(reqSpan in, reqBatch &out)
+{
+    thread_local std::vector<uint64_t> keys;
+    keys.resize(in.size);
+    for (int i = 0; i < in.size; i++)
+        keys[i] = (uint64_t)in.track[i] << 32 | (uint32_t)in.sector[i];
+    std::sort(keys.begin(), keys.end());
+    for (int i = 0; i < in.size; i++)
+    {
+        out.track[i] = (int)(keys[i] >> 32);
+        out.sector[i] = (int)(uint32_t)keys[i];
+    }
+}
+
+/*
+    void parallelSortRequests(in, &out, &pool)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Sort a very large batch of requests on a thread pool, with the same two stable
+        counting passes as sortRequests (sector into a pooled scratch batch, then track into out).
+        In each pass every slice of the batch counts its own keys, the counts are turned into
+        output offsets ordered by key and then by slice, and every slice scatters into place, so
+        the result is the same stable order sortRequests produces. The counts are one per key and
+        slice, kept in a per-thread buffer that is reused from one sort to the next.
+    parameters:
+        in     I/P  reqSpan     View of I/O requests to be sorted
+        &out   O/P  reqBatch    Sorted requests; must already hold in.size entries
+        &pool  I/P  threadPool  Threads to use, one slice each; must be idle
+*/
+void parallelSortRequests(reqSpan in, reqBatch &out, threadPool &pool)
+{
+    const int n = in.size, slices = pool.size();
+    pooledBatch scratch(threadReqPool());
+    scratch->resize(n);
+    // the slices run on other threads, which must reach this thread's buffer, not their own
+    thread_local std::vector<int> offsetBuffer;
+    std::vector<int> &offsets = offsetBuffer;
+
+    // one stable counting pass on key[], moving (track, sector) pairs from one batch to another
+    auto pass = [&](const int *key, int keys, const int *fromTrack, const int *fromSector, int *toTrack,
+                    int *toSector) {
+        offsets.assign((size_t)slices * keys, 0);
+        pool.run(slices, [&](int t, int) {
+            int *count = offsets.data() + (size_t)t * keys;
+            for (int i = (int)((long long)n * t / slices), last = (int)((long long)n * (t + 1) / slices); i < last; i++)
+                count[key[i]]++;
+        });
+
+        // offsets in key order, then slice order, keep the pass stable
+        int sum = 0;
+        for (int k = 0; k < keys; k++)
+            for (int t = 0; t < slices; t++)
+            {
+                int &o = offsets[(size_t)t * keys + k];
+                int c = o;
+                o = sum;
+                sum += c;
+            }
+
+        pool.run(slices, [&](int t, int) {
+            int *pos = offsets.data() + (size_t)t * keys;
+            for (int i = (int)((long long)n * t / slices), last = (int)((long long)n * (t + 1) / slices); i < last; i++)
+            {
+                int p = pos[key[i]]++;
+                toTrack[p] = fromTrack[i];
+                toSector[p] = fromSector[i];
+            }
+        });
+    };
+
+    int *tmpTrack = scratch->track.data();
+    int *tmpSector = scratch->sector.data();
+    pass(in.sector, drive.maxSectors, in.track, in.sector, tmpTrack, tmpSector);
+    pass(tmpTrack, drive.tracks, tmpTrack, tmpSector, out.track.data(), out.sector.data());
+}
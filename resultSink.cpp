@@ -0,0 +1,414 @@
+/*
+file: resultSink.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    bufferedWriter - Constructor method that starts a buffered writer on an open file.
+    bufferedWriter::write - Append bytes to the buffer.
+    bufferedWriter::print - Append printf-formatted text to the buffer.
+    bufferedWriter::flush - Hand the buffered bytes to the file.
+    appendText - Append printf-formatted text to a SINK_LINE buffer.
+    resultSink - Constructor method that starts a sink writing one format to a file.
+    resultSink::begin - Start a record.
+    resultSink::field - Add a string, integer or floating point field to the current record.
+    resultSink::end - Finish the current record.
+    resultSink::finish - Write out everything still buffered.
+    resultSink::flushGroup - Write the binary row group collected so far.
+*/
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdarg>
+
+#define WRITER_BUFFER (1 << 16)     // Bytes a bufferedWriter collects before writing them out
+#define SINK_LINE 4096              // Longest CSV row or header
+#define SINK_MAX_FIELDS 32          // Most fields in one record
+#define BIN_GROUP_ROWS 1024         // Most rows in one binary row group
+
+/* Output buffered in a fixed array: appending never allocates, and the file sees large writes */
+class bufferedWriter
+{
+public:
+    bufferedWriter(FILE *out);
+    ~bufferedWriter() { flush(); }
+    void write(const void *bytes, size_t len);
+    void print(const char *format, ...);
+    void flush();
+
+private:
+    FILE *out;
+    size_t used;
+    char buffer[WRITER_BUFFER];
+};
+
+/* Machine-readable results. A run is written as a series of records, each a kind plus named fields;
+   records of one kind always have the same fields in the same order. Formats:
+       'c'  CSV: a header row whenever the record kind changes, then one row per record; the first
+            column is the kind
+       'j'  JSON Lines: one object per record, the kind in its "record" member
+       'b'  columnar binary, native byte order: the magic "HDDSIMR1", then row groups of up to
+            BIN_GROUP_ROWS consecutive records of one kind. A group is
+                u8 kind length, kind, u16 columns, u32 rows,
+                per column: u8 name length, name, u8 type ('i' int64, 'd' float64, 's' string),
+                per column: its rows' values; a string is a u16 length and its bytes
+   Values are formatted straight into fixed buffers, so writing a record does not allocate; the
+   binary column buffers grow to the largest group once and are reused. */
+class resultSink
+{
+public:
+    resultSink(char format, FILE *out);
+    ~resultSink() { finish(); }
+    void begin(const char *kind);
+    void field(const char *name, const char *value);
+    void field(const char *name, long long value);
+    void field(const char *name, double value);
+    void field(const char *name, int value) { field(name, (long long)value); }
+    void field(const char *name, float value) { field(name, (double)value); }
+    void field(const char *name, bool value) { field(name, (long long)value); }
+    void end();
+    void finish();
+
+private:
+    void column(const char *name, char type);
+    void flushGroup();
+
+    char format;
+    bufferedWriter out;
+    const char *kind;           // Kind of the current record
+    const char *lastKind;       // Kind of the previous record (CSV header, binary group)
+    int fields;                 // Fields added to the current record
+
+    // CSV: the row is built here, and the header too when the kind changed
+    char line[SINK_LINE];
+    size_t lineUsed;
+    char header[SINK_LINE];
+    size_t headerUsed;
+
+    // binary: the current row group's columns
+    int groupRows;
+    int groupColumns;
+    const char *columnName[SINK_MAX_FIELDS];
+    char columnType[SINK_MAX_FIELDS];
+    std::vector<char> columnData[SINK_MAX_FIELDS];
+};
+
+/*
+    bufferedWriter(out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that starts a buffered writer on an open file.
+    parameters:
+        out  I/P  FILE*  File to write to; stays open
+*/
+bufferedWriter::bufferedWriter(FILE *out) : out(out), used(0)
+{
+}
+
+/*
+    void write(bytes, len)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Append bytes to the buffer, writing the buffer out first if they do not fit.
+    parameters:
+        bytes  I/P  void*   Bytes to append
+        len    I/P  size_t  Number of bytes
+*/
+void bufferedWriter::write(const void *bytes, size_t len)
+{
+    if (used + len > WRITER_BUFFER)
+        flush();
+    if (len > WRITER_BUFFER)
+    {
+        fwrite(bytes, 1, len, out);
+        return;
+    }
+    memcpy(buffer + used, bytes, len);
+    used += len;
+}
+
+/*
+    void print(format, ...)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Append printf-formatted text to the buffer. Text longer than SINK_LINE is cut.
+    parameters:
+        format  I/P  char*  printf format
+        ...     I/P  any    Values to format
+*/
+void bufferedWriter::print(const char *format, ...)
+{
+    if (used + SINK_LINE > WRITER_BUFFER)
+        flush();
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buffer + used, SINK_LINE, format, args);
+    va_end(args);
+    used += len < 0 ? 0 : std::min(len, SINK_LINE - 1);
+}
+
+/*
+    void flush()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Hand the buffered bytes to the file.
+*/
+void bufferedWriter::flush()
+{
+    if (used > 0)
+        fwrite(buffer, 1, used, out);
+    used = 0;
+    fflush(out);
+}
+
+/*
+    void appendText(buf, &used, format, ...)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Append printf-formatted text to a SINK_LINE buffer, cutting it at the end of the
+        buffer.
+    parameters:
+        buf     I/P  char*   Buffer of SINK_LINE bytes
+        &used   I/P  size_t  Bytes of buf in use; updated
+        format  I/P  char*   printf format
+        ...     I/P  any     Values to format
+*/
+void appendText(char *buf, size_t &used, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buf + used, SINK_LINE - used, format, args);
+    va_end(args);
+    used = len < 0 ? used : std::min(used + len, (size_t)SINK_LINE - 1);
+}
+
+/*
+    resultSink(format, out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that starts a sink writing one format to a file.
+    parameters:
+        format  I/P  char   'c' CSV, 'j' JSON Lines or 'b' binary
+        out     I/P  FILE*  File to write to; stays open
+*/
+resultSink::resultSink(char format, FILE *out)
+    : format(format), out(out), kind(nullptr), lastKind(nullptr), fields(0), lineUsed(0), headerUsed(0),
+      groupRows(0), groupColumns(0)
+{
+    if (format == 'b')
+        this->out.write("HDDSIMR1", 8);
+}
+
+/*
+    void begin(kind)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Start a record.
+    parameters:
+        kind  I/P  char*  Record kind; records of one kind have the same fields
+*/
+void resultSink::begin(const char *kind)
+{
+    this->kind = kind;
+    fields = 0;
+    lineUsed = 0;
+    headerUsed = 0;
+    if (format == 'c')
+    {
+        appendText(line, lineUsed, "%s", kind);
+        appendText(header, headerUsed, "record");
+    }
+    else if (format == 'j')
+        out.print("{\"record\":\"%s\"", kind);
+    else if (format == 'b' && (lastKind == nullptr || strcmp(kind, lastKind) != 0 || groupRows == BIN_GROUP_ROWS))
+        flushGroup();
+}
+
+/*
+    void column(name, type)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Note the name of the next field: into the CSV header, or as a column of a new
+        binary row group.
+    parameters:
+        name  I/P  char*  Field name
+        type  I/P  char   Binary column type: 'i', 'd' or 's'
+*/
+void resultSink::column(const char *name, char type)
+{
+    if (format == 'c')
+        appendText(header, headerUsed, ",%s", name);
+    else if (format == 'b' && groupRows == 0 && fields < SINK_MAX_FIELDS)
+    {
+        columnName[fields] = name;
+        columnType[fields] = type;
+        columnData[fields].clear();
+        groupColumns = fields + 1;
+    }
+}
+
+/*
+    void field(name, value)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Add a string field to the current record. JSON strings have quotes and backslashes
+        escaped; CSV strings holding a comma, quote or newline are quoted.
+    parameters:
+        name   I/P  char*  Field name
+        value  I/P  char*  Value
+*/
+void resultSink::field(const char *name, const char *value)
+{
+    column(name, 's');
+    if (format == 'c' && strpbrk(value, ",\"\n") == nullptr)
+        appendText(line, lineUsed, ",%s", value);
+    else if (format == 'c')
+    {
+        // quoted, with quotes doubled
+        appendText(line, lineUsed, ",\"");
+        for (const char *c = value; *c; c++)
+            appendText(line, lineUsed, *c == '"' ? "\"\"" : "%c", *c);
+        appendText(line, lineUsed, "\"");
+    }
+    else if (format == 'j')
+    {
+        out.print(",\"%s\":\"", name);
+        for (const char *c = value; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                out.write("\\", 1);
+            out.write(c, 1);
+        }
+        out.write("\"", 1);
+    }
+    else if (format == 'b' && fields < groupColumns)
+    {
+        uint16_t len = (uint16_t)std::min(strlen(value), (size_t)UINT16_MAX);
+        std::vector<char> &data = columnData[fields];
+        data.insert(data.end(), (const char *)&len, (const char *)&len + sizeof len);
+        data.insert(data.end(), value, value + len);
+    }
+    fields++;
+}
+
+/*
+    void field(name, value)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Add an integer field to the current record.
+    parameters:
+        name   I/P  char*      Field name
+        value  I/P  long long  Value
+*/
+void resultSink::field(const char *name, long long value)
+{
+    column(name, 'i');
+    if (format == 'c')
+        appendText(line, lineUsed, ",%lld", value);
+    else if (format == 'j')
+        out.print(",\"%s\":%lld", name, value);
+    else if (format == 'b' && fields < groupColumns)
+    {
+        int64_t v = value;
+        columnData[fields].insert(columnData[fields].end(), (const char *)&v, (const char *)&v + sizeof v);
+    }
+    fields++;
+}
+
+/*
+    void field(name, value)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Add a floating point field to the current record. Text formats use 9 significant
+        digits, enough to read a float back exactly; JSON writes infinities and NaN as null.
+    parameters:
+        name   I/P  char*   Field name
+        value  I/P  double  Value
+*/
+void resultSink::field(const char *name, double value)
+{
+    column(name, 'd');
+    if (format == 'c')
+        appendText(line, lineUsed, ",%.9g", value);
+    else if (format == 'j')
+    {
+        if (std::isfinite(value))
+            out.print(",\"%s\":%.9g", name, value);
+        else
+            out.print(",\"%s\":null", name);
+    }
+    else if (format == 'b' && fields < groupColumns)
+        columnData[fields].insert(columnData[fields].end(), (const char *)&value, (const char *)&value + sizeof value);
+    fields++;
+}
+
+/*
+    void end()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Finish the current record: write the CSV row (after a header row if the kind
+        changed), close the JSON object, or count the binary row.
+*/
+void resultSink::end()
+{
+    if (format == 'c')
+    {
+        if (lastKind == nullptr || strcmp(kind, lastKind) != 0)
+        {
+            out.write(header, headerUsed);
+            out.write("\n", 1);
+        }
+        out.write(line, lineUsed);
+        out.write("\n", 1);
+    }
+    else if (format == 'j')
+        out.write("}\n", 2);
+    else if (format == 'b')
+        groupRows++;
+    lastKind = kind;
+}
+
+/*
+    void flushGroup()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Write the binary row group collected so far (see resultSink) and start a new one.
+*/
+void resultSink::flushGroup()
+{
+    if (groupRows > 0)
+    {
+        uint8_t kindLen = (uint8_t)strlen(lastKind);
+        uint16_t columns = (uint16_t)groupColumns;
+        uint32_t rows = (uint32_t)groupRows;
+        out.write(&kindLen, 1);
+        out.write(lastKind, kindLen);
+        out.write(&columns, sizeof columns);
+        out.write(&rows, sizeof rows);
+        for (int c = 0; c < groupColumns; c++)
+        {
+            uint8_t nameLen = (uint8_t)strlen(columnName[c]);
+            out.write(&nameLen, 1);
+            out.write(columnName[c], nameLen);
+            out.write(&columnType[c], 1);
+        }
+        for (int c = 0; c < groupColumns; c++)
+            out.write(columnData[c].data(), columnData[c].size());
+    }
+    groupRows = 0;
+    groupColumns = 0;
+}
+
+/*
+    void finish()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Write out everything still buffered. Called by the destructor; safe to call twice.
+*/
+void resultSink::finish()
+{
+    if (format == 'b')
+        flushGroup();
+    out.flush();
+}
@@ -0,0 +1,255 @@
+/*
+file: runningStats.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    runningStats::clear - Forget every value added so far.
+    runningStats::add - Add one value.
+    runningStats::merge - Combine the values of another runningStats.
+    runningStats::halfWidth - Half-width of the confidence interval of the mean.
+    runningCov::clear - Forget every pair added so far.
+    runningCov::add - Add one pair of values.
+    runningCov::merge - Combine the pairs of another runningCov.
+    runningCov::controlledMean - Control variate estimate of the mean of y.
+    runningCov::controlledHalfWidth - Half-width of the confidence interval of controlledMean.
+    tQuantile - Two-sided 95 % quantile of Student's t distribution.
+*/
+
+/* Two-sided 95 % normal quantile; confidence intervals use Student's t (tQuantile), which tends
+   to it as the number of samples grows */
+#define CI_Z 1.959964
+
+double tQuantile(long long df);
+
+/* Running count, mean and sum of squared deviations of a series of values (Welford's method), kept
+   in double so the variance does not cancel out. Merging partial stats in a fixed order gives the
+   same result however the values were split up. */
+struct runningStats
+{
+    long long n;                // Values added
+    double mean;                // Mean of the values
+    double m2;                  // Sum of squared deviations from the mean
+
+    runningStats() { clear(); }
+    void clear();
+    inline void add(double x);
+    void merge(const runningStats &other);
+    double variance() const { return n > 1 ? m2 / (n - 1) : 0; }
+    double halfWidth() const;
+};
+
+/* Running means, squared deviations and co-deviation of a series of (x, y) pairs, for estimating
+   the mean of y with x as a control variate: a value with known mean that is correlated with y.
+   Merged like runningStats. */
+struct runningCov
+{
+    long long n;                // Pairs added
+    double meanX;               // Mean of the x values
+    double meanY;               // Mean of the y values
+    double m2X;                 // Sum of squared deviations of x
+    double m2Y;                 // Sum of squared deviations of y
+    double cXY;                 // Sum of products of the x and y deviations
+
+    runningCov() { clear(); }
+    void clear();
+    inline void add(double x, double y);
+    void merge(const runningCov &other);
+    double halfWidth() const;
+    double controlledMean(double muX) const;
+    double controlledHalfWidth() const;
+};
+
+/*
+    void clear()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Forget every value added so far.
+*/
+void runningStats::clear()
+{
+    n = 0;
+    mean = 0;
+    m2 = 0;
+}
+
+/*
+    void add(x)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Add one value, updating the mean and squared deviations in a single pass.
+    parameters:
+        x  I/P  double  Value to add
+*/
+inline void runningStats::add(double x)
+{
+    n++;
+    double delta = x - mean;
+    mean += delta / n;
+    m2 += delta * (x - mean);
+}
+
+/*
+    void merge(other)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Combine the values of another runningStats into this one (Chan et al.'s pairwise
+        update), as if they had been added one by one.
+    parameters:
+        other  I/P  runningStats  Stats to combine
+*/
+void runningStats::merge(const runningStats &other)
+{
+    if (other.n == 0)
+        return;
+    long long total = n + other.n;
+    double delta = other.mean - mean;
+    mean += delta * other.n / total;
+    m2 += other.m2 + delta * delta * ((double)n * other.n / total);
+    n = total;
+}
+
+/*
+    double halfWidth()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Half-width of the 95 % confidence interval of the mean.
+    parameters:
+        halfWidth  O/P  double  tQuantile(n - 1) standard errors; infinite with fewer than two values
+*/
+double runningStats::halfWidth() const
+{
+    if (n < 2)
+        return HUGE_VAL;
+    return tQuantile(n - 1) * sqrt(variance() / n);
+}
+
+/*
+    void clear()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Forget every pair added so far.
+*/
+void runningCov::clear()
+{
+    n = 0;
+    meanX = meanY = 0;
+    m2X = m2Y = cXY = 0;
+}
+
+/*
+    void add(x, y)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Add one pair of values.
+    parameters:
+        x  I/P  double  Control value
+        y  I/P  double  Value whose mean is estimated
+*/
+inline void runningCov::add(double x, double y)
+{
+    n++;
+    double dx = x - meanX;
+    double dy = y - meanY;
+    meanX += dx / n;
+    meanY += dy / n;
+    m2X += dx * (x - meanX);
+    m2Y += dy * (y - meanY);
+    cXY += dx * (y - meanY);
+}
+
+/*
+    void merge(other)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Combine the pairs of another runningCov into this one.
+    parameters:
+        other  I/P  runningCov  Stats to combine
+*/
+void runningCov::merge(const runningCov &other)
+{
+    if (other.n == 0)
+        return;
+    long long total = n + other.n;
+    double dx = other.meanX - meanX;
+    double dy = other.meanY - meanY;
+    double w = (double)n * other.n / total;
+    meanX += dx * other.n / total;
+    meanY += dy * other.n / total;
+    m2X += other.m2X + dx * dx * w;
+    m2Y += other.m2Y + dy * dy * w;
+    cXY += other.cXY + dx * dy * w;
+    n = total;
+}
+
+/*
+    double halfWidth()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Half-width of the 95 % confidence interval of the plain mean of y.
+    parameters:
+        halfWidth  O/P  double  Half-width; infinite with fewer than two pairs
+*/
+double runningCov::halfWidth() const
+{
+    if (n < 2)
+        return HUGE_VAL;
+    return tQuantile(n - 1) * sqrt(m2Y / (n - 1) / n);
+}
+
+/*
+    double controlledMean(muX)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Control variate estimate of the mean of y: the mean of y less beta times the
+        amount the mean of x missed its known expectation, with beta the least squares slope of y
+        on x. A control that does not vary leaves the plain mean.
+    parameters:
+        muX             I/P  double  Exact expectation of x
+        controlledMean  O/P  double  Estimate of the mean of y
+*/
+double runningCov::controlledMean(double muX) const
+{
+    double beta = m2X > 0 ? cXY / m2X : 0;
+    return meanY - beta * (meanX - muX);
+}
+
+/*
+    double controlledHalfWidth()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Half-width of the 95 % confidence interval of controlledMean, from the variance of
+        y left over after the regression on x (one more degree of freedom is spent on beta).
+    parameters:
+        controlledHalfWidth  O/P  double  Half-width; infinite with fewer than three pairs
+*/
+double runningCov::controlledHalfWidth() const
+{
+    if (n < 3)
+        return HUGE_VAL;
+    double residual = m2X > 0 ? m2Y - cXY * cXY / m2X : m2Y;
+    return tQuantile(n - 2) * sqrt(std::max(0.0, residual) / (n - 2) / n);
+}
+
+/*
+    double tQuantile(df)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Two-sided 95 % quantile of Student's t distribution: tabulated up to 30 degrees of
+        freedom, beyond that the Cornish-Fisher expansion around CI_Z (accurate to 1e-4).
+    parameters:
+        df         I/P  long long  Degrees of freedom, at least 1
+        tQuantile  O/P  double     Quantile
+*/
+double tQuantile(long long df)
+{
+    static const double table[31] = {0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                     2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110,
+                                     2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056,
+                                     2.052, 2.048, 2.045, 2.042};
+    if (df <= 30)
+        return table[df < 1 ? 1 : df];
+    const double z = CI_Z, z3 = z * z * z, z5 = z3 * z * z, v = (double)df;
+    return z + (z3 + z) / (4 * v) + (5 * z5 + 16 * z3 + 3 * z) / (96 * v * v);
+}
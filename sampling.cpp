@@ -0,0 +1,323 @@
+/*
+file: sampling.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    samplingConfig::block - Experiments per independent replicate under the sampling mode.
+    mixBits - Scramble the bits of a 32-bit value.
+    sampleHash - Random 32 bits for one coordinate of one request of a replicate.
+    reverseBits - Reverse the order of the bits of a 32-bit value.
+    owenScramble - Nested uniform (Owen) scramble of a 32-bit fixed-point value.
+    sobolPoint - The two coordinates of a point of the 2D Sobol sequence.
+    replicateStrata - Shuffled strata of every request of a stratified replicate.
+    sampleRequests - Generate an experiment's requests with a variance reduction sampling mode.
+    fifoSeekControl - FIFO seek time of a request set, the control variate.
+    fifoSeekMean - Exact expectation of the control variate.
+*/
+
+#include <cstdint>
+
+/* Experiments of one stratified or Sobol replicate; a whole work chunk, so a replicate never spans
+   two tasks */
+#define SAMPLE_BLOCK_BITS 5
+static_assert((1 << SAMPLE_BLOCK_BITS) == CHUNK_SIZE, "a sampling replicate is one work chunk");
+
+/* Fourth counter word of the block a replicate's scramble is drawn from; request blocks only reach
+   it in a stream of 2^63 requests (see drawRequests) */
+#define SAMPLE_COUNTER 0x80000000u
+
+/* How the sweep draws its request sets. In every mode each experiment's requests are independent
+   and uniform on the drive, so the expectation being estimated is unchanged; the modes other than
+   uniform correlate the experiments of a replicate (block() of them, starting at a multiple of
+   block() experiments) so that the replicate's mean varies less. The replicate mean is then the
+   independent sample the confidence interval is computed from. */
+struct samplingConfig
+{
+    char mode;                  // 'u' uniform, 'a' antithetic pairs, 's' stratified, 'q' scrambled Sobol
+    bool control;               // Correct avgReqTime with the FIFO seek time control variate
+
+    int block() const;
+};
+
+/* Sampling of the sweep; uniform unless --sampling or --control say otherwise */
+samplingConfig sampling = {'u', false};
+
+/*
+    int block()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Experiments per independent replicate under the sampling mode.
+    parameters:
+        block  O/P  int  1 uniform, 2 antithetic, CHUNK_SIZE stratified and Sobol
+*/
+int samplingConfig::block() const
+{
+    if (mode == 'a')
+        return 2;
+    if (mode == 's' || mode == 'q')
+        return 1 << SAMPLE_BLOCK_BITS;
+    return 1;
+}
+
+/*
+    uint32_t mixBits(x)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Scramble the bits of a 32-bit value (a bijective integer hash with low bias).
+    parameters:
+        x        I/P  uint32_t  Value
+        mixBits  O/P  uint32_t  Hashed value
+*/
+inline uint32_t mixBits(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/*
+    uint32_t sampleHash(scramble, slot, dim)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Random 32 bits for one coordinate of one request of a replicate. Counter based, so
+        any experiment's requests can be drawn without drawing the ones before it.
+    parameters:
+        scramble    I/P  uint32_t  Scramble of the replicate the experiment belongs to (see sampleRequests)
+        slot        I/P  uint32_t  Index of the request within the experiment
+        dim         I/P  uint32_t  Which of the request's random numbers
+        sampleHash  O/P  uint32_t  Random bits
+*/
+inline uint32_t sampleHash(uint32_t scramble, uint32_t slot, uint32_t dim)
+{
+    uint32_t h = mixBits(scramble + 0x9e3779b9u);
+    h = mixBits(h ^ (slot * 0x85ebca6bu));
+    return mixBits(h ^ (dim * 0xc2b2ae35u + 0x27d4eb2fu));
+}
+
+/*
+    uint32_t reverseBits(x)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Reverse the order of the bits of a 32-bit value.
+    parameters:
+        x            I/P  uint32_t  Value
+        reverseBits  O/P  uint32_t  Value with bit 0 swapped with bit 31 and so on
+*/
+inline uint32_t reverseBits(uint32_t x)
+{
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+    x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+/*
+    uint32_t owenScramble(x, seed)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Nested uniform (Owen) scramble of a 32-bit fixed-point value, hash based (Burley,
+        "Practical Hash-based Owen Scrambling"). Each bit is flipped depending only on the bits
+        above it, so the values of any aligned block of 2^m stay an aligned block of 2^m, and a
+        scrambled net is still a net with every point uniform on [0, 1).
+    parameters:
+        x             I/P  uint32_t  Value, read as x / 2^32
+        seed          I/P  uint32_t  Scramble
+        owenScramble  O/P  uint32_t  Scrambled value
+*/
+inline uint32_t owenScramble(uint32_t x, uint32_t seed)
+{
+    x = reverseBits(x);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return reverseBits(x);
+}
+
+/*
+    void sobolPoint(j, &x0, &x1)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: The two coordinates of point j of the 2D Sobol sequence, as 32-bit fixed point.
+        The first is the van der Corput sequence, the second uses the direction numbers of the
+        polynomial x + 1. Every aligned block of 2^m points is a (0, m, 2)-net: each of the 2^m
+        boxes of any 2^a by 2^(m-a) grid holds exactly one point.
+    parameters:
+        j    I/P  uint32_t  Index of the point
+        &x0  O/P  uint32_t  First coordinate
+        &x1  O/P  uint32_t  Second coordinate
+*/
+inline void sobolPoint(uint32_t j, uint32_t &x0, uint32_t &x1)
+{
+    x0 = reverseBits(j);
+    x1 = 0;
+    for (uint32_t v = 1u << 31; j != 0; j >>= 1, v ^= v >> 1)
+        if (j & 1)
+            x1 ^= v;
+}
+
+/*
+    uint8_t *replicateStrata(scramble, n)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Shuffled strata of every request of a stratified replicate: for request k and
+        coordinate d, an independent uniformly random permutation of the block() strata (Fisher-Yates
+        on sampleHash), one entry per experiment of the replicate. The experiments of a replicate are
+        generated one after another by the thread that runs its chunk, so the permutations are built
+        once for the replicate and kept until the next one.
+    parameters:
+        scramble         I/P  uint32_t  Scramble of the replicate (see sampleRequests)
+        n                I/P  int       Number of requests in every experiment
+        replicateStrata  O/P  uint8_t*  Stratum of experiment i's request k, coordinate d at
+                                        [(2 * k + d) * block() + i]
+*/
+const uint8_t *replicateStrata(uint32_t scramble, int n)
+{
+    thread_local vector<uint8_t> strata;
+    thread_local uint32_t cachedScramble;
+    thread_local int cachedN = 0;
+    const int block = 1 << SAMPLE_BLOCK_BITS;
+
+    if (cachedN != n || cachedScramble != scramble)
+    {
+        strata.resize((size_t)2 * n * block);
+        for (int p = 0; p < 2 * n; p++)
+        {
+            uint8_t *perm = &strata[(size_t)p * block];
+            for (int i = 0; i < block; i++)
+                perm[i] = (uint8_t)i;
+            for (int i = block - 1; i > 0; i--)
+            {
+                uint32_t j = (uint32_t)(((uint64_t)sampleHash(scramble, p, 0x10000 + i) * (i + 1)) >> 32);
+                std::swap(perm[i], perm[j]);
+            }
+        }
+        cachedScramble = scramble;
+        cachedN = n;
+    }
+    return strata.data();
+}
+
+/*
+    void sampleRequests(n, key, &requests)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Generate an experiment's requests with the variance reduction sampling mode
+        (generateRequests hands every mode but uniform here). The experiment belongs to replicate
+        key.index / block() and is number key.index % block() within it. Every random number of the
+        replicate is hashed (sampleHash) from one scramble, the first word of Philox block
+        (replicate, 0, n, SAMPLE_COUNTER) under the experiment's key, so any experiment is
+        generated on its own. Request k of the experiment takes a track from one random coordinate
+        and a sector of that track from the other:
+            antithetic  the second experiment of a pair uses the complement of the first's
+                        coordinates, mirroring each request's track around the middle of the disk
+                        and its sector around the middle of the track
+            stratified  across a replicate, request k's coordinates take one value in each of the
+                        block() equal strata of [0, 1), in an order shuffled independently per
+                        request and coordinate (a Latin hypercube over the replicate's experiments)
+            sobol       across a replicate, request k's (track, sector) pairs are the points of a
+                        2D Sobol net in shuffled order, Owen scrambled independently per request
+        Tracks and sectors are scaled from 32-bit coordinates (placeRequest), so they are uniform to
+        within 2^-32.
+    parameters:
+        n         I/P  int            Number of requests to generate
+        key       I/P  experimentKey  Experiment whose requests are generated (see above)
+        requests  O/P  reqBatch       Batch of simulated I/O requests
+*/
+void sampleRequests(int n, experimentKey key, reqBatch &requests)
+{
+    const uint32_t block = (uint32_t)sampling.block();
+    const uint32_t i = key.index % block;
+    uint32_t ctr[4] = {key.index / block, 0, (uint32_t)n, SAMPLE_COUNTER}, words[4];
+    philox4x32(ctr, key.seed, key.stream, words);
+    const uint32_t scramble = words[0];
+    const uint8_t *strata = sampling.mode == 's' ? replicateStrata(scramble, n) : nullptr;
+    requests.resize(n);
+
+    for (int k = 0; k < n; k++)
+    {
+        uint32_t x0, x1;
+        if (sampling.mode == 'a')
+        {
+            x0 = sampleHash(scramble, k, 0);
+            x1 = sampleHash(scramble, k, 1);
+            if (i != 0)
+            {
+                x0 = ~x0;
+                x1 = ~x1;
+            }
+        }
+        else if (sampling.mode == 's')
+        {
+            // the experiment's stratum, then a uniform position inside it
+            uint32_t s0 = strata[(2 * k) * block + i];
+            uint32_t s1 = strata[(2 * k + 1) * block + i];
+            x0 = (s0 << (32 - SAMPLE_BLOCK_BITS)) | (sampleHash(scramble, k, 2 + 2 * i) >> SAMPLE_BLOCK_BITS);
+            x1 = (s1 << (32 - SAMPLE_BLOCK_BITS)) | (sampleHash(scramble, k, 3 + 2 * i) >> SAMPLE_BLOCK_BITS);
+        }
+        else
+        {
+            // shuffling the index keeps the replicate's points one aligned block of the sequence
+            sobolPoint(owenScramble(i, sampleHash(scramble, k, 0)), x0, x1);
+            x0 = owenScramble(x0, sampleHash(scramble, k, 1));
+            x1 = owenScramble(x1, sampleHash(scramble, k, 2));
+        }
+
+        placeRequest(x0, x1, requests.track[k], requests.sector[k]);
+    }
+}
+
+/*
+    double fifoSeekControl(in)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: FIFO seek time of a request set: the seek time from the start track to the first
+        request and from each request to the next, in the order generated. Strongly correlated with
+        every scheduler's total time and with a mean known exactly (fifoSeekMean), which makes it
+        the control variate of --control.
+    parameters:
+        in               I/P  reqSpan  View of simulated I/O requests
+        fifoSeekControl  O/P  double   Seek time in milliseconds
+*/
+double fifoSeekControl(reqSpan in)
+{
+    const float *seek = drive.seekTable.data();
+    double total = 0;
+    int at = startHead().track;
+    for (int k = 0; k < in.size; k++)
+    {
+        total += seek[abs(in.track[k] - at)];
+        at = in.track[k];
+    }
+    return total;
+}
+
+/*
+    double fifoSeekMean(n)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Exact expectation of fifoSeekControl over n requests on uniform tracks: the mean
+        seek from the start track to a uniform track, plus n - 1 times the mean seek between two
+        independent uniform tracks, whose distance d > 0 has probability 2 (T - d) / T^2.
+    parameters:
+        n             I/P  int     Number of requests in the experiment
+        fifoSeekMean  O/P  double  Expected seek time in milliseconds
+*/
+double fifoSeekMean(int n)
+{
+    const double tracks = drive.tracks;
+    const int start = startHead().track;
+    double first = 0, pair = 0;
+    for (int t = 0; t < drive.tracks; t++)
+        first += drive.seekTable[abs(t - start)];
+    for (int d = 1; d < drive.tracks; d++)
+        pair += 2 * (tracks - d) * drive.seekTable[d];
+    return first / tracks + (n - 1) * pair / (tracks * tracks);
+}
@@ -0,0 +1,250 @@
+/*
+file: schedPolicy.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    schedPolicy::events - Run the discrete-event simulation with the policy's queue.
+    schedRegistry - The registered scheduling policies, in registration order.
+    findPolicy - Look a registered policy up by name.
+    schedRegistrar - Constructor method that adds a policy to the registry.
+*/
+
+/* A scheduling policy is a struct deriving from schedPolicy<Policy, Geometry> (CRTP) that provides:
+       name           display name, also used to select it with --algs
+       id             single character used in progress messages
+       fixedOrder     true if the service order is known before the first request is serviced
+       run            service one batch of requests and return the experiment statistics
+       serviceWindow  service one window of a stream from wherever the head is (see streamSim.cpp)
+       queue          pending request set used by the event simulation and onlineScheduler, built
+                      by makeQueue
+   Elevator policies (elevatorPolicy) also provide:
+       sweepPlan      lay out a batch in service order from a starting track (see elevator.cpp)
+   Fixed-order policies also provide, for the SIMD lane evaluator:
+       order          lay out a batch in service order (sector -1 entries are head moves)
+       extraSteps     how many head moves order may add on top of the requests
+   The sweep drivers are templates instantiated once per policy, so every call into the policy is
+   resolved at compile time. */
+template <class Policy, class Geometry = defaultGeometry>
+struct schedPolicy
+{
+    typedef Geometry geometry;
+    static constexpr int extraSteps = 0;
+
+    static eventResults events(const arrivalConfig &arrivals)
+    {
+        typename Policy::queue q = Policy::makeQueue();
+        return runEventSim(arrivals, q);
+    }
+};
+
+/* The elevator algorithms share their lane layout and are run from their sweepPlan; name, plan
+   and queue differ */
+template <class Policy, char Id>
+struct elevatorPolicy : schedPolicy<Policy>
+{
+    static constexpr char id = Id;
+    static constexpr bool fixedOrder = true;
+    static constexpr int extraSteps = 2;
+
+    static reqSpan order(reqSpan in, reqBatch &sorted, reqBatch &plan)
+    {
+        Policy::sweepPlan(in, START_HEAD.track, sorted, plan);
+        return plan.span();
+    }
+    static void serviceWindow(headState &head, reqSpan in, hddSim &sim) { elevatorService<Policy>(head, in, sim); }
+};
+
+struct fifoPolicy : schedPolicy<fifoPolicy>
+{
+    static constexpr const char *name = "FIFO";
+    static constexpr char id = 'a';
+    static constexpr bool fixedOrder = true;
+    typedef fifoQueue queue;
+    static queue makeQueue() { return queue(); }
+    static hddSim run(reqSpan in) { return fifo(in); }
+    static void serviceWindow(headState &head, reqSpan in, hddSim &sim) { serviceSequence(head, in, 0, in.size - 1, sim); }
+    static reqSpan order(reqSpan in, reqBatch &, reqBatch &) { return in; }
+};
+
+struct sstfPolicy : schedPolicy<sstfPolicy>
+{
+    static constexpr const char *name = "SSTF";
+    static constexpr char id = 'b';
+    static constexpr bool fixedOrder = false;
+    typedef sstfQueue queue;
+    static queue makeQueue() { return queue(); }
+    static hddSim run(reqSpan in) { return sstf(in); }
+    static void serviceWindow(headState &head, reqSpan in, hddSim &sim) { sstfService(head, in, sim); }
+};
+
+struct scanPolicy : elevatorPolicy<scanPolicy, 'c'>
+{
+    static constexpr const char *name = "SCAN";
+    typedef elevatorQueue queue;
+    static queue makeQueue() { return queue(true, false); }
+    static hddSim run(reqSpan in) { return scan(in); }
+    static void sweepPlan(reqSpan in, int startTrack, reqBatch &sorted, reqBatch &plan)
+    {
+        planSweep<scanTurn>(in, startTrack, sorted, plan);
+    }
+};
+
+struct lifoPolicy : schedPolicy<lifoPolicy>
+{
+    static constexpr const char *name = "LIFO";
+    static constexpr char id = 'd';
+    static constexpr bool fixedOrder = true;
+    typedef lifoQueue queue;
+    static queue makeQueue() { return queue(); }
+    static hddSim run(reqSpan in) { return lifo(in); }
+    static void serviceWindow(headState &head, reqSpan in, hddSim &sim) { serviceSequence(head, in, in.size - 1, 0, sim); }
+    static reqSpan order(reqSpan in, reqBatch &, reqBatch &plan)
+    {
+        plan.resize(in.size);
+        for (int i = 0; i < in.size; i++)
+        {
+            plan.track[i] = in.track[in.size - 1 - i];
+            plan.sector[i] = in.sector[in.size - 1 - i];
+        }
+        return plan.span();
+    }
+};
+
+struct cscanPolicy : elevatorPolicy<cscanPolicy, 'e'>
+{
+    static constexpr const char *name = "C-SCAN";
+    typedef elevatorQueue queue;
+    static queue makeQueue() { return queue(true, true); }
+    static hddSim run(reqSpan in) { return cscan(in); }
+    static void sweepPlan(reqSpan in, int startTrack, reqBatch &sorted, reqBatch &plan)
+    {
+        planSweep<cscanTurn>(in, startTrack, sorted, plan);
+    }
+};
+
+struct lookPolicy : elevatorPolicy<lookPolicy, 'f'>
+{
+    static constexpr const char *name = "LOOK";
+    typedef elevatorQueue queue;
+    static queue makeQueue() { return queue(false, false); }
+    static hddSim run(reqSpan in) { return look(in); }
+    static void sweepPlan(reqSpan in, int startTrack, reqBatch &sorted, reqBatch &plan)
+    {
+        planSweep<lookTurn>(in, startTrack, sorted, plan);
+    }
+};
+
+struct clookPolicy : elevatorPolicy<clookPolicy, 'g'>
+{
+    static constexpr const char *name = "C-LOOK";
+    typedef elevatorQueue queue;
+    static queue makeQueue() { return queue(false, true); }
+    static hddSim run(reqSpan in) { return clook(in); }
+    static void sweepPlan(reqSpan in, int startTrack, reqBatch &sorted, reqBatch &plan)
+    {
+        planSweep<clookTurn>(in, startTrack, sorted, plan);
+    }
+};
+
+struct nstepPolicy : elevatorPolicy<nstepPolicy, 'h'>
+{
+    static constexpr const char *name = "N-SCAN";
+    typedef nstepQueue queue;
+    static queue makeQueue() { return queue(nstepSize); }
+    static hddSim run(reqSpan in) { return nstepScan(in); }
+    static void sweepPlan(reqSpan in, int startTrack, reqBatch &sorted, reqBatch &plan)
+    {
+        planNStep(in, startTrack, sorted, plan);
+    }
+};
+
+struct fscanPolicy : elevatorPolicy<fscanPolicy, 'i'>
+{
+    static constexpr const char *name = "FSCAN";
+    typedef fscanQueue queue;
+    static queue makeQueue() { return queue(); }
+    static hddSim run(reqSpan in) { return fscan(in); }
+    static void sweepPlan(reqSpan in, int startTrack, reqBatch &sorted, reqBatch &plan)
+    {
+        planSweep<lookTurn>(in, startTrack, sorted, plan);
+    }
+};
+
+/* One registered policy: its name plus the drivers instantiated for it */
+struct schedEntry
+{
+    const char *name;                                               // Display name
+    char id;                                                        // Progress message character
+    vector<results> (*sweep)(const simConfig &, threadPool &);      // executeAlg<Policy>
+    vector<pointPartial> (*shard)(const simConfig &, threadPool &); // shardAlg<Policy>
+    hddSim (*run)(reqSpan);                                         // Policy::run
+    eventResults (*events)(const arrivalConfig &);                  // Policy::events
+    streamResults (*stream)(const streamConfig &);                  // streamRun<Policy>
+    arrayResults (*array)(const arrayConfig &, const streamConfig &, threadPool &); // arrayRun<Policy>
+    onlineResults (*online)(const onlineConfig &);                  // onlineStress<Policy>
+};
+
+/*
+    vector<schedEntry> &schedRegistry()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: The registered scheduling policies, in registration order. Built on first use so
+        registrations made during static initialisation always find it.
+    parameters:
+        schedRegistry  O/P  vector<schedEntry>  Registered policies
+*/
+vector<schedEntry> &schedRegistry()
+{
+    static vector<schedEntry> registry;
+    return registry;
+}
+
+/*
+    int findPolicy(name)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Look a registered policy up by name, ignoring case.
+    parameters:
+        name        I/P  char*  Policy name
+        findPolicy  O/P  int    Index into schedRegistry, or -1 if no policy has that name
+*/
+int findPolicy(const char *name)
+{
+    const vector<schedEntry> &registry = schedRegistry();
+    for (int p = 0; p < (int)registry.size(); p++)
+        if (strcasecmp(name, registry[p].name) == 0)
+            return p;
+    return -1;
+}
+
+/*
+    schedRegistrar<Policy>()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that adds a policy to the registry. Declare one static instance
+        per policy (REGISTER_POLICY); policies are listed in the order they are registered.
+*/
+template <class Policy>
+struct schedRegistrar
+{
+    schedRegistrar()
+    {
+        schedRegistry().push_back(
+            schedEntry{Policy::name, Policy::id, &executeAlg<Policy>, &shardAlg<Policy>, &Policy::run,
+                       &Policy::events, &streamRun<Policy>, &arrayRun<Policy>, &onlineStress<Policy>});
+    }
+};
+#define REGISTER_POLICY(P) static schedRegistrar<P> P##Registrar;
+
+/* The first DEFAULT_ALGS registered run when --algs is not given */
+REGISTER_POLICY(fifoPolicy)
+REGISTER_POLICY(sstfPolicy)
+REGISTER_POLICY(scanPolicy)
+REGISTER_POLICY(lifoPolicy)
+REGISTER_POLICY(cscanPolicy)
+REGISTER_POLICY(lookPolicy)
+REGISTER_POLICY(clookPolicy)
+REGISTER_POLICY(nstepPolicy)
+REGISTER_POLICY(fscanPolicy)
@@ -0,0 +1,214 @@
+/*
+file: selfProfile.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    profileTicks - Read the profiling clock.
+    phaseTimer - Constructor method that starts timing a phase, pausing the phase it interrupts.
+    ~phaseTimer - Destructor method that stops timing the phase and resumes the one it interrupted.
+    profileTotals - Sum the phase counters of every thread.
+    reportProfile - Print or write the time the simulator spent in each phase.
+*/
+
+/* Phases of the simulator's own work, timed when it is built with -DHDDSIM_PROFILE */
+enum profilePhase
+{
+    PHASE_GENERATE,             // Producing requests: generateRequests and stream and array windows
+    PHASE_SORT,                 // sortRequests, wherever it is called from
+    PHASE_SCHEDULE,             // Ordering and servicing requests, and the rest of an experiment
+    PROFILE_PHASES
+};
+
+const char *const PROFILE_PHASE_NAMES[PROFILE_PHASES] = {"generate", "sort", "schedule"};
+
+#ifdef HDDSIM_PROFILE
+
+#include <deque>
+#include <mutex>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* A phase is timed from PROFILE_PHASE to the end of the enclosing scope. Phases nest: a phase
+   started inside another pauses it, so each tick is counted in exactly one phase, the innermost.
+   The counters are per thread and only read once the pool is idle, so timing takes no lock and no
+   atomic; a phase boundary costs one read of the time stamp counter. Built without the flag,
+   PROFILE_PHASE is empty and nothing is timed. */
+#define PROFILE_PHASE(phase) phaseTimer phaseScope(phase)
+
+/* One thread's time in each phase */
+struct phaseCounters
+{
+    uint64_t ticks[PROFILE_PHASES];     // Profiling clock ticks spent in the phase
+    long long calls[PROFILE_PHASES];    // Times the phase was entered
+    int current;                        // Phase being timed, -1 for none
+    uint64_t since;                     // Tick the current phase was last started or resumed at
+};
+
+/* Totals of every thread, in seconds */
+struct profileSummary
+{
+    long long calls[PROFILE_PHASES];    // Times each phase was entered
+    double seconds[PROFILE_PHASES];     // Thread time spent in each phase
+};
+
+/* Every thread's counters; a deque so they never move as threads are added, and kept until exit
+   so the totals can be read after the threads are gone */
+std::deque<phaseCounters> profileThreads;
+std::mutex profileThreadsLock;
+thread_local phaseCounters *threadPhases = nullptr;
+
+/*
+    uint64_t profileTicks()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Read the profiling clock: the time stamp counter on x86, steady_clock nanoseconds
+        elsewhere. Ticks are turned into seconds against steady_clock over the whole run.
+    parameters:
+        profileTicks  O/P  uint64_t  Current tick
+*/
+inline uint64_t profileTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/* Both clocks at static initialisation, the reference profileTotals converts ticks against */
+const uint64_t profileStartTick = profileTicks();
+const std::chrono::steady_clock::time_point profileStartTime = std::chrono::steady_clock::now();
+
+/* Times one phase for the lifetime of the object (see PROFILE_PHASE) */
+class phaseTimer
+{
+public:
+    explicit phaseTimer(profilePhase phase);
+    ~phaseTimer();
+
+private:
+    int outer;                  // Phase that was being timed when this one started
+};
+
+/*
+    phaseTimer(phase)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that starts timing a phase on the current thread, adding the
+        ticks so far to the phase it interrupts. A thread's counters are registered the first time
+        it times anything.
+    parameters:
+        phase  I/P  profilePhase  Phase entered
+*/
+inline phaseTimer::phaseTimer(profilePhase phase)
+{
+    if (threadPhases == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(profileThreadsLock);
+        profileThreads.push_back(phaseCounters{{0}, {0}, -1, 0});
+        threadPhases = &profileThreads.back();
+    }
+    phaseCounters &c = *threadPhases;
+    const uint64_t now = profileTicks();
+    if (c.current >= 0)
+        c.ticks[c.current] += now - c.since;
+    outer = c.current;
+    c.current = phase;
+    c.since = now;
+}
+
+/*
+    ~phaseTimer()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Destructor method that stops timing the phase and resumes the one it interrupted.
+*/
+inline phaseTimer::~phaseTimer()
+{
+    phaseCounters &c = *threadPhases;
+    const uint64_t now = profileTicks();
+    c.ticks[c.current] += now - c.since;
+    c.calls[c.current]++;
+    c.current = outer;
+    c.since = now;
+}
+
+/*
+    profileSummary profileTotals()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Sum the phase counters of every thread. Only called while no phase is being
+        timed on another thread, such as between pool runs.
+    parameters:
+        profileTotals  O/P  profileSummary  Calls and thread seconds of each phase
+*/
+profileSummary profileTotals()
+{
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - profileStartTime).count();
+    const uint64_t ticks = profileTicks() - profileStartTick;
+    const double secondsPerTick = ticks > 0 ? wall / ticks : 0;
+
+    profileSummary sum = {{0}, {0}};
+    std::lock_guard<std::mutex> lock(profileThreadsLock);
+    for (const phaseCounters &c : profileThreads)
+        for (int p = 0; p < PROFILE_PHASES; p++)
+        {
+            sum.calls[p] += c.calls[p];
+            sum.seconds[p] += c.ticks[p] * secondsPerTick;
+        }
+    return sum;
+}
+
+/*
+    void reportProfile(&sink, tables)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Print the time the simulator spent in each phase as a table, or write it through
+        the sink as one "profile" record per phase. Times are summed over threads, so they can add
+        up to more than the run's wall time. Nothing is reported for a run that timed nothing, such
+        as a merge of shard files.
+    parameters:
+        &sink   I/P  resultSink  Sink the records are written to; unused for tables
+        tables  I/P  bool        Print a table instead of writing records
+*/
+void reportProfile(resultSink &sink, bool tables)
+{
+    const profileSummary sum = profileTotals();
+    long long calls = 0;
+    for (int p = 0; p < PROFILE_PHASES; p++)
+        calls += sum.calls[p];
+    if (calls == 0)
+        return;
+
+    if (tables)
+        std::cout << "Self-profile:\n Phase     |    Calls     |  Thread Time  |  Per Call\n";
+    for (int p = 0; p < PROFILE_PHASES; p++)
+    {
+        const double perCall = sum.calls[p] > 0 ? sum.seconds[p] * 1e9 / sum.calls[p] : 0;
+        if (tables)
+        {
+            printf("%-10s\t%lld\t%.3f s\t%.1f ns\n", PROFILE_PHASE_NAMES[p], sum.calls[p], sum.seconds[p], perCall);
+            continue;
+        }
+        sink.begin("profile");
+        sink.field("phase", PROFILE_PHASE_NAMES[p]);
+        sink.field("calls", sum.calls[p]);
+        sink.field("thread_s", sum.seconds[p]);
+        sink.field("ns_per_call", perCall);
+        sink.end();
+    }
+    if (tables)
+        std::cout << std::endl;
+}
+
+#else
+
+#define PROFILE_PHASE(phase) ((void)0)
+
+inline void reportProfile(resultSink &, bool) {}
+
+#endif
@@ -0,0 +1,395 @@
+/*
+file: serviceKernel.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    buildTimeTables - Fill the seek and rotation lookup tables.
+    withGeometry - Run a kernel instantiated for the geometry of the simulated drive.
+    startHead - Head position every experiment starts from.
+    updateSector - Produce an updated sector value based on the given time value.
+    moveHead - Seek the disk head to a track without servicing anything.
+    serviceRequest - Move the disk head to one request and return the time it cost.
+    serviceSequence - Service a pre-ordered run of requests and add the costs to an experiment.
+    newSim - Create an empty set of experiment statistics.
+    finishSim - Convert an experiment's running sums into averages.
+*/
+
+/* The kernel functions below are templates on a geometry type with this static interface:
+       zoneOf(track)        zone of a track
+       sectors(zone)        sectors per track in the zone
+       sectorRate(zone)     sectors passing the head per ms of clock
+       seek(distance)       seek time in ms
+       rotation(zone, n)    rotational latency in ms for n sectors waited
+   driveGeometry has the built-in drive's numbers as compile-time constants, so its instantiation
+   folds them into the code; zonedGeometry reads the tables of whatever drive was loaded. */
+
+/* ROT_FACTOR = RPMS / 360 rounded to float; the factor between sectors and milliseconds in the
+   rotation model */
+const float ROT_FACTOR = (float)(RPMS / 360);
+
+/* Lookup tables for the time components of the built-in drive. All clock arithmetic is single
+   float additions of table entries, so the lane-parallel evaluator (laneEval.cpp) reproduces it bit
+   for bit. */
+float SEEK_TABLE[TRACKS];      // Seek time in ms indexed by track distance
+float ROT_TABLE[SECTORS + 1];  // Rotational latency in ms indexed by sectors waited
+
+/* Uniform drive geometry as compile-time parameters, so code templated on it sees constant bounds.
+   Its times come from SEEK_TABLE and ROT_TABLE, which are built for defaultGeometry. */
+template <int Tracks, int Sectors, int Rpm>
+struct driveGeometry
+{
+    static constexpr int tracks = Tracks;               // Number of tracks
+    static constexpr int sectorsPerTrack = Sectors;     // Sectors per track
+    static constexpr int rpm = Rpm;                     // Rotations per minute
+
+    static int zoneOf(int) { return 0; }
+    static int sectors(int) { return Sectors; }
+    static float sectorRate(int) { return ROT_FACTOR; }
+    static float seek(int distance) { return SEEK_TABLE[distance]; }
+    static float rotation(int, int n) { return ROT_TABLE[n]; }
+};
+
+/* The built-in drive */
+typedef driveGeometry<TRACKS, SECTORS, RPM> defaultGeometry;
+
+/* The loaded drive, read through its lookup tables (see driveModel) */
+struct zonedGeometry
+{
+    static int zoneOf(int track) { return drive.trackZone[track]; }
+    static int sectors(int zone) { return drive.zones[zone].sectors; }
+    static float sectorRate(int zone) { return drive.zones[zone].sectorRate; }
+    static float seek(int distance) { return drive.seekTable[distance]; }
+    static float rotation(int zone, int n) { return drive.rotTable[drive.zones[zone].rotBase + n]; }
+};
+
+/* Position of the disk head together with the experiment's clock */
+struct headState
+{
+    int track;                  // Track the head is over
+    int sector;                 // Sector the head is over
+    float clock;                // Simulated time elapsed in milliseconds
+};
+
+/* Time cost of servicing one request */
+struct serviceCost
+{
+    int distance;               // Number of tracks crossed by the seek
+    float seek;                 // Seek time in milliseconds
+    float rotation;             // Rotational latency in milliseconds
+    float transfer;             // Transfer time in milliseconds
+    bool missed;                // The sector had just passed, so the head waited for it to come round again
+};
+
+/* Head position every experiment on the built-in drive starts from (see startHead) */
+const headState START_HEAD = {100, 0, 0};
+
+/*
+    bool buildTimeTables()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Fill the seek and rotation lookup tables. Runs once during static initialisation.
+    parameters:
+        buildTimeTables  O/P  bool  Always true
+*/
+bool buildTimeTables()
+{
+    for (int d = 0; d < TRACKS; d++)
+        SEEK_TABLE[d] = (float)d * AVG_SEEK_TIME;
+    for (int s = 0; s <= SECTORS; s++)
+        ROT_TABLE[s] = (float)s * ROT_FACTOR;
+    return true;
+}
+const bool timeTablesBuilt = buildTimeTables();
+
+/*
+    auto withGeometry(fn)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run a kernel instantiated for the geometry of the simulated drive: fn is called with
+        a defaultGeometry when the drive is the built-in one, and with a zonedGeometry otherwise.
+        Callers branch once per call here, so the loops inside fn run without checking again.
+    parameters:
+        fn            I/P  callable  Generic lambda taking the geometry as its argument
+        withGeometry  O/P  auto      Whatever fn returns
+*/
+template <class Fn>
+inline auto withGeometry(Fn &&fn) -> decltype(fn(defaultGeometry()))
+{
+    if (drive.isDefault)
+        return fn(defaultGeometry());
+    return fn(zonedGeometry());
+}
+
+/*
+    headState startHead()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Head position every experiment starts from: the middle track, sector 0, at time 0.
+        START_HEAD on the built-in drive.
+    parameters:
+        startHead  O/P  headState  Starting head position and clock
+*/
+inline headState startHead()
+{
+    return headState{drive.tracks / 2, 0, 0};
+}
+
+/*
+    int updateSector<Geometry>(int zone, float currentTime)
+    author: Gherkin
+    date: Nov 22, 2020
+    description: Produce an updated sector value based on the given time value
+    parameters:
+        Geometry      I/P  class  Drive geometry (driveGeometry or zonedGeometry)
+        zone          I/P  int    Zone of the track the head is over
+        currentTime   I/P  float  Time value used to calculate sector position
+        updateSector  O/P  int    Updated value of sector position
+*/
+template <class Geometry>
+inline int updateSector(int zone, float currentTime)
+{
+    const int sectors = Geometry::sectors(zone);
+    int s = (int)(currentTime * Geometry::sectorRate(zone));
+    s -= (sectors * (s / sectors));
+    s -= 1;
+    return s;
+}
+
+/*
+    int updateSector(int sector, int duration, int sectors)
+    author: Gherkin
+    date: Nov 22, 2020
+    description: Increased the current sector value based on the given time value. The head wraps
+        back to sector 0 after the last sector; computed directly rather than one sector at a time.
+        A duration never exceeds one rotation, so at most one wrap is needed.
+    parameters:
+        sector        I/P  int  Current sector position value
+        duration      I/P  int  Duration of time
+        sectors       I/P  int  Sectors on the track
+        updateSector  O/P  int  Increased value of sector position
+*/
+inline int updateSector(int sector, int duration, int sectors)
+{
+    int sec = sector + duration;
+    return sec >= sectors ? sec - sectors : sec;
+}
+
+/*
+    int moveHead<Geometry>(&head, track)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Seek the disk head to a track without servicing anything. The platter keeps spinning
+        during the seek, so the head ends up over the sector given by the clock. The overload without
+        a geometry picks the simulated drive's (see withGeometry).
+    parameters:
+        Geometry  I/P  class      Drive geometry (driveGeometry or zonedGeometry)
+        &head     I/P  headState  Head position and clock; updated in place
+        track     I/P  int        Destination track
+        moveHead  O/P  int        Number of tracks crossed
+*/
+template <class Geometry>
+inline int moveHead(headState &head, int track)
+{
+    int distance = abs(track - head.track);
+    if (distance != 0)
+    {
+        head.clock += Geometry::seek(distance);
+        head.track = track;
+        head.sector = updateSector<Geometry>(Geometry::zoneOf(track), head.clock); // accounting for disk spin while seeking
+    }
+    return distance;
+}
+
+inline int moveHead(headState &head, int track)
+{
+    return withGeometry([&](auto g) { return moveHead<decltype(g)>(head, track); });
+}
+
+/*
+    serviceCost serviceRequest<Geometry>(&head, track, sector, blocks)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Move the disk head to one request and return the time it cost. The head is updated
+        in place: it seeks to the request's track if it is not already there (the platter keeps
+        spinning meanwhile), waits for the sector to come round, then transfers the request's
+        blocks. The clock advances by each component in turn. A merged request (see reqMerge.cpp)
+        reads its further blocks as their sectors pass under the head, so their rotation counts
+        as transfer time. The overload without a geometry picks the simulated drive's (see
+        withGeometry).
+    parameters:
+        Geometry        I/P  class        Drive geometry (driveGeometry or zonedGeometry)
+        &head           I/P  headState    Head position and clock before the request
+        &head           O/P  headState    Head position and clock after the request
+        track           I/P  int          Track value of the request
+        sector          I/P  int          Sector value of the request (its first, if merged)
+        blocks          I/P  int          Contiguous blocks transferred, all on the track (1 by default)
+        serviceRequest  O/P  serviceCost  Time spent on the request
+*/
+template <class Geometry>
+inline serviceCost serviceRequest(headState &head, int track, int sector, int blocks = 1)
+{
+    serviceCost c;
+
+    // switch tracks if needed
+    c.distance = moveHead<Geometry>(head, track);
+    c.seek = Geometry::seek(c.distance);
+
+    // calculate rotational latency; when the sector has passed, wait for the rest of the rotation
+    const int zone = Geometry::zoneOf(track);
+    const int sectors = Geometry::sectors(zone);
+    c.missed = sector < head.sector;
+    int sectDiff = c.missed ? (sectors - 1 - head.sector) + sector : sector - head.sector;
+    head.sector = updateSector(head.sector, sectDiff, sectors);
+    c.rotation = Geometry::rotation(zone, sectDiff);
+    head.clock += c.rotation;
+
+    // transfer the first block, then any others as they come under the head
+    head.clock += TRANSFER_MS;
+    c.transfer = TRANSFER_MS;
+    if (blocks > 1)
+    {
+        const float more = Geometry::rotation(zone, blocks - 1) + (blocks - 1) * TRANSFER_MS;
+        head.sector = updateSector(head.sector, blocks - 1, sectors);
+        head.clock += more;
+        c.transfer += more;
+    }
+    return c;
+}
+
+inline serviceCost serviceRequest(headState &head, int track, int sector, int blocks = 1)
+{
+    return withGeometry([&](auto g) { return serviceRequest<decltype(g)>(head, track, sector, blocks); });
+}
+
+/*
+    void serviceSequence(&head, req, first, last, &sim)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Service the requests req[first] through req[last] in order and add the costs to an
+        experiment. last may be below first, in which case the requests are serviced in descending
+        index order. Entries with sector -1 are head moves (see appendMove) and are only seeked to.
+        When the thread has an activeCache, a request it holds is served from the buffer for its
+        blocks' transfer without moving the head, and any other is cached as it is read. When the
+        thread has an activeMerger, the requests are those it merged and each one transfers the
+        blocks of its extent. The loop is instantiated apart for either, so runs without them do
+        not check for them. When the thread has a latencySink, each request's completion time
+        (from latencyOrigin) is recorded into it, once for every original request of a merged one.
+        The time components are summed in service order on top of the experiment's, one float
+        addition each, in the same order as the lane evaluator. The loop is instantiated once per
+        geometry and picked once per call.
+    parameters:
+        &head  I/P  headState  Head position and clock; updated as requests are serviced
+        req    I/P  reqSpan    Requests, already in the order they should be serviced
+        first  I/P  int        Index of the first request to service
+        last   I/P  int        Index of the last request to service
+        &sim   I/P  hddSim     Experiment statistics that the costs are added to
+*/
+inline void serviceSequence(headState &head, reqSpan req, int first, int last, hddSim &sim)
+{
+    const int step = last >= first ? 1 : -1;
+    latencyHist *sink = latencySink;
+    driveCache *cache = activeCache;
+    const reqMerger *merger = activeMerger;
+    const float origin = latencyOrigin;
+    int hits = 0;
+    auto loop = [&](auto g, auto cached, auto merged) {
+        typedef decltype(g) Geometry;
+        // local copies, so the cache's stores cannot be taken to alias the head or the sums
+        headState h = head;
+        float seekTime = sim.seekTime, rotationTime = sim.rotationTime, transferTime = sim.transferTime;
+        int seeks = 0, switches = 0, missed = 0;
+        for (int i = first; i != last + step; i += step)
+        {
+            if (req.sector[i] < 0)
+            {
+                const int distance = moveHead<Geometry>(h, req.track[i]);
+                seeks += distance;
+                seekTime += Geometry::seek(distance);
+                switches += distance != 0;
+            }
+            else
+            {
+                int blocks = 1, members = 1;
+                if (decltype(merged)::value)
+                    blocks = merger->extent(req.track[i], req.sector[i], members);
+                if (decltype(cached)::value && cache->access(req.track[i], req.sector[i]))
+                {
+                    h.clock += blocks * TRANSFER_MS;
+                    transferTime += blocks * TRANSFER_MS;
+                    hits++;
+                }
+                else
+                {
+                    serviceCost c = serviceRequest<Geometry>(h, req.track[i], req.sector[i], blocks);
+                    seeks += c.distance;
+                    seekTime += c.seek;
+                    rotationTime += c.rotation;
+                    transferTime += c.transfer;
+                    switches += c.distance != 0;
+                    missed += c.missed;
+                }
+                if (sink)
+                    sink->record(h.clock - origin, members);
+            }
+        }
+        head = h;
+        sim.seekTime = seekTime;
+        sim.rotationTime = rotationTime;
+        sim.transferTime = transferTime;
+        sim.trackSwitches += switches;
+        sim.missedRotations += missed;
+        return seeks;
+    };
+    int seekSum = withGeometry([&](auto g) {
+        if (merger)
+            return cache ? loop(g, std::true_type(), std::true_type()) : loop(g, std::false_type(), std::true_type());
+        return cache ? loop(g, std::true_type(), std::false_type()) : loop(g, std::false_type(), std::false_type());
+    });
+
+    sim.avgSeekLength += seekSum;
+    sim.seekTracks += seekSum;
+    sim.cacheHits += hits;
+    sim.totalTime = head.clock;
+}
+
+/*
+    hddSim newSim(n)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Create an empty set of experiment statistics.
+    parameters:
+        n       I/P  int     Number of requests in the experiment
+        newSim  O/P  hddSim  Zeroed statistics
+*/
+inline hddSim newSim(int n)
+{
+    hddSim sim;
+    sim.totalRequests = n;
+    sim.totalTime = 0;
+    sim.avgSeekLength = 0;
+    sim.totalAvgAccessTime = drive.accessTime;
+    sim.fifoSeek = 0;
+    sim.cacheHits = 0;
+    sim.seekTime = 0;
+    sim.rotationTime = 0;
+    sim.transferTime = 0;
+    sim.trackSwitches = 0;
+    sim.missedRotations = 0;
+    sim.seekTracks = 0;
+    return sim;
+}
+
+/*
+    void finishSim(&sim)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Convert an experiment's running sums into averages.
+    parameters:
+        &sim  I/P  hddSim  Experiment statistics
+*/
+inline void finishSim(hddSim &sim)
+{
+    sim.avgSeekLength /= sim.totalRequests;
+}
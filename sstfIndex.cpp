@@ -0,0 +1,230 @@
+/*
+file: sstfIndex.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    occupancyBitmap::reset - Size the bitmap and clear every bit.
+    occupancyBitmap::set - Mark a track as having pending requests.
+    occupancyBitmap::clear - Mark a track as having no pending requests.
+    occupancyBitmap::nextSet - Find the first marked track at or above a track.
+    occupancyBitmap::prevSet - Find the last marked track at or below a track.
+    nearestTrack - Find the marked track closest to the head.
+    sectorAfterSeek - Sector the head will be over once it has seeked to a track.
+*/
+
+#include <cstdint>
+
+/* Hierarchical bitmap with one bit per track. Each level above the first holds one bit per non-zero
+   word of the level below, so finding the next or previous set bit takes one word per level:
+   two levels cover 4096 tracks, three cover 262144. */
+class occupancyBitmap
+{
+public:
+    void reset(int n);
+    void set(int i);
+    void clear(int i);
+    bool test(int i) const { return (levels[0][i >> 6] >> (i & 63)) & 1; }
+    bool any() const { return levels.back()[0] != 0; }
+    int nextSet(int i) const;
+    int prevSet(int i) const;
+
+private:
+    std::vector<std::vector<uint64_t>> levels;
+    int bits = 0;
+};
+
+/*
+    void reset(n)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Size the bitmap for n tracks and clear every bit. Storage is kept when the size
+        does not change.
+    parameters:
+        n  I/P  int  Number of tracks
+*/
+void occupancyBitmap::reset(int n)
+{
+    if (n != bits || levels.empty())
+    {
+        bits = n;
+        levels.clear();
+        int words = n;
+        do
+        {
+            words = (words + 63) / 64;
+            levels.push_back(std::vector<uint64_t>(words, 0));
+        } while (words > 1);
+        return;
+    }
+    for (std::vector<uint64_t> &level : levels)
+        std::fill(level.begin(), level.end(), 0);
+}
+
+/*
+    void set(i)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Mark a track as having pending requests.
+    parameters:
+        i  I/P  int  Track to mark
+*/
+void occupancyBitmap::set(int i)
+{
+    for (std::vector<uint64_t> &level : levels)
+    {
+        level[i >> 6] |= 1ULL << (i & 63);
+        i >>= 6;
+    }
+}
+
+/*
+    void clear(i)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Mark a track as having no pending requests.
+    parameters:
+        i  I/P  int  Track to clear
+*/
+void occupancyBitmap::clear(int i)
+{
+    for (std::vector<uint64_t> &level : levels)
+    {
+        uint64_t &w = level[i >> 6];
+        w &= ~(1ULL << (i & 63));
+        if (w != 0)
+            return;
+        i >>= 6;
+    }
+}
+
+/*
+    int nextSet(i)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Find the first marked track at or above a track.
+    parameters:
+        i        I/P  int  Track to search from
+        nextSet  O/P  int  First marked track >= i, or -1 if there is none
+*/
+int occupancyBitmap::nextSet(int i) const
+{
+    if (i < 0)
+        i = 0;
+    if (i >= bits)
+        return -1;
+
+    // climb until a word with a set bit at or after the position is found
+    size_t lvl = 0;
+    while (true)
+    {
+        if (lvl == levels.size())
+            return -1;
+        size_t w = i >> 6;
+        if (w >= levels[lvl].size())
+            return -1;
+        uint64_t m = levels[lvl][w] & (~0ULL << (i & 63));
+        if (m != 0)
+        {
+            i = (int)(w * 64 + __builtin_ctzll(m));
+            break;
+        }
+        i = (int)w + 1;
+        lvl++;
+    }
+
+    // descend to the lowest set bit under it
+    while (lvl > 0)
+    {
+        lvl--;
+        i = i * 64 + __builtin_ctzll(levels[lvl][i]);
+    }
+    return i;
+}
+
+/*
+    int prevSet(i)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Find the last marked track at or below a track.
+    parameters:
+        i        I/P  int  Track to search from
+        prevSet  O/P  int  Last marked track <= i, or -1 if there is none
+*/
+int occupancyBitmap::prevSet(int i) const
+{
+    if (i >= bits)
+        i = bits - 1;
+    if (i < 0)
+        return -1;
+
+    // climb until a word with a set bit at or before the position is found
+    size_t lvl = 0;
+    while (true)
+    {
+        if (lvl == levels.size())
+            return -1;
+        int w = i >> 6;
+        int b = i & 63;
+        uint64_t m = levels[lvl][w] & (b == 63 ? ~0ULL : (2ULL << b) - 1);
+        if (m != 0)
+        {
+            i = w * 64 + 63 - __builtin_clzll(m);
+            break;
+        }
+        i = w - 1;
+        if (i < 0)
+            return -1;
+        lvl++;
+    }
+
+    // descend to the highest set bit under it
+    while (lvl > 0)
+    {
+        lvl--;
+        i = i * 64 + 63 - __builtin_clzll(levels[lvl][i]);
+    }
+    return i;
+}
+
+/*
+    int nearestTrack(occ, track)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Find the marked track closest to the head. Ties go to the higher track.
+    parameters:
+        occ           I/P  occupancyBitmap  Tracks with pending requests
+        track         I/P  int              Track the head is over
+        nearestTrack  O/P  int              Closest marked track, or -1 if none are marked
+*/
+inline int nearestTrack(const occupancyBitmap &occ, int track)
+{
+    int up = occ.nextSet(track);
+    int down = occ.prevSet(track);
+    if (up < 0)
+        return down;
+    if (down < 0)
+        return up;
+    return up - track <= track - down ? up : down;
+}
+
+/*
+    int sectorAfterSeek(head, track)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Sector the head will be over once it has seeked to a track, following the same
+        rules as serviceRequest.
+    parameters:
+        head             I/P  headState  Current head position and clock
+        track            I/P  int        Destination track
+        sectorAfterSeek  O/P  int        Sector under the head on arrival
+*/
+inline int sectorAfterSeek(const headState &head, int track)
+{
+    if (track == head.track)
+        return head.sector;
+    headState moved = head;
+    moveHead(moved, track);
+    return moved.sector;
+}
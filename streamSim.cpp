@@ -0,0 +1,265 @@
+/*
+file: streamSim.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    genSource - Constructor method that starts a lazily generated request stream.
+    genSource::fill - Generate the next window of requests.
+    traceSource - Constructor method that starts a request stream read from a trace.
+    traceSource::fill - Read the next window of requests from the trace.
+    streamWindow - Service one window of a stream from wherever the head is.
+    streamWindows - Service a request stream window by window with one scheduling policy.
+    streamRun - Run one streaming experiment with one scheduling policy.
+*/
+
+/* Settings of a streaming run */
+struct streamConfig
+{
+    long long requests;         // Requests in the experiment; 0 runs until a trace runs out
+    int window;                 // Requests admitted to the scheduler at a time
+    unsigned seed;              // Randomization seed of the generated stream
+    const traceFile *trace;     // Trace to stream instead of generated requests, or null
+    char traceFormat;           // Trace: 'b' blkparse or 'm' MSR CSV
+    uint64_t traceSpan;         // Trace: traced device size in bytes for mapLba (0 wraps)
+};
+
+/* Statistics from one streaming experiment, accumulated window by window */
+struct streamResults
+{
+    long long requests;         // Requests serviced
+    double simTime;             // Simulated time to service them all in ms
+    double avgSeek;             // Mean tracks crossed per request
+    long long cacheHits;        // Requests served from the drive cache, counted after merging
+    long long merged;           // Requests folded into another by the merge stage (see reqMerge.cpp)
+    latencySummary latency;     // Time from a request's window being admitted to its completion
+    double wallSeconds;         // Real time the run took
+};
+
+/* Uniform random requests drawn on demand, straight from their counters (drawRequests) as the
+   experiment (seed, STREAM_WINDOWS, 0) of cfg.requests requests. A stream is therefore the same
+   whatever the window size, and one that fits in one window matches the materialized experiment. */
+class genSource
+{
+public:
+    genSource(const streamConfig &cfg);
+    int fill(reqBatch &window, int max);
+
+private:
+    experimentKey key;
+    uint32_t n;                 // Low 32 bits of the request count, part of every counter
+    long long next;             // Index of the next request
+};
+
+/* Requests read from a mapped trace in file order; arrival times are ignored */
+class traceSource
+{
+public:
+    traceSource(const streamConfig &cfg);
+    int fill(reqBatch &window, int max);
+
+private:
+    traceReader reader;
+    uint64_t span;
+};
+
+/*
+    genSource(cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that starts a lazily generated request stream.
+    parameters:
+        cfg  I/P  streamConfig  Streaming settings; cfg.seed and cfg.requests name the stream
+*/
+genSource::genSource(const streamConfig &cfg)
+    : key{cfg.seed, STREAM_WINDOWS, 0}, n((uint32_t)cfg.requests), next(0)
+{
+}
+
+/*
+    int fill(&window, max)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Generate the next window of requests, overwriting the batch in place.
+    parameters:
+        &window  O/P  reqBatch  Requests of the window
+        max      I/P  int       Number of requests wanted
+        fill     O/P  int       Number of requests produced (always max)
+*/
+int genSource::fill(reqBatch &window, int max)
+{
+    PROFILE_PHASE(PHASE_GENERATE);
+    window.resize(max);
+    drawRequests(key, n, next, max, window.track.data(), window.sector.data());
+    next += max;
+    return max;
+}
+
+/*
+    traceSource(cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that starts a request stream read from a trace.
+    parameters:
+        cfg  I/P  streamConfig  Streaming settings; cfg.trace must be set
+*/
+traceSource::traceSource(const streamConfig &cfg) : reader(*cfg.trace, cfg.traceFormat), span(cfg.traceSpan)
+{
+}
+
+/*
+    int fill(&window, max)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Read the next window of requests from the trace, mapping each onto the drive.
+    parameters:
+        &window  O/P  reqBatch  Requests of the window
+        max      I/P  int       Number of requests wanted
+        fill     O/P  int       Number of requests read; fewer than max at the end of the trace
+*/
+int traceSource::fill(reqBatch &window, int max)
+{
+    PROFILE_PHASE(PHASE_GENERATE);
+    window.resize(max);
+    traceRecord r;
+    int k = 0;
+    while (k < max && reader.next(r))
+    {
+        mapLba(r.offset, span, window.track[k], window.sector[k]);
+        k++;
+    }
+    window.resize(k);
+    return k;
+}
+
+/*
+    void streamWindow<Policy>(&head, window, &elapsed, &seeks, &hits)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Service one window of a stream with Policy::serviceWindow from wherever the head
+        is, recording latencies from the moment the window is admitted into the thread's
+        latencySink. The window's time is the sum of its seek, rotation and transfer times, added
+        to the stream's in double, and its tracks crossed are counted as integers, so neither
+        drifts with the length of the stream. The head clock is a float, like the kernels', and is
+        brought back into [0, rotationPeriod) after every window with fmod in double. It therefore
+        never grows past one rotation period plus a window. Its resolution within a window is still
+        that of a float of up to that size (about 0.06 ms for the built-in drive's 648 s period).
+        Sector positions inside a long window are rounded to that much.
+    parameters:
+        Policy    I/P  class      Scheduling policy (see schedPolicy.cpp)
+        &head     I/P  headState  Head position and clock; updated as the window is serviced
+        window    I/P  reqSpan    Requests of the window, at least one
+        &elapsed  I/P  double     Elapsed time of the stream in ms; the window's time is added
+        &seeks    I/P  long long  Tracks crossed by the stream; the window's are added
+        &hits     I/P  long long  Requests of the stream served from the drive cache; the window's are added
+*/
+template <class Policy>
+void streamWindow(headState &head, reqSpan window, double &elapsed, long long &seeks, long long &hits)
+{
+    PROFILE_PHASE(PHASE_SCHEDULE);
+    float start = head.clock;
+    latencyOrigin = start;
+    hddSim sim = newSim(window.size);
+    Policy::serviceWindow(head, window, sim);
+
+    elapsed += (double)sim.seekTime + sim.rotationTime + sim.transferTime;
+    seeks += sim.seekTracks;
+    hits += sim.cacheHits;
+    head.clock = (float)fmod((double)head.clock, drive.rotationPeriod);
+}
+
+/*
+    streamResults streamWindows<Policy>(&source, cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Service a request stream window by window with one scheduling policy. Each window
+        is handed to Policy::serviceWindow with the head where the previous window left it, and the
+        statistics are summed as it goes, so memory is bounded by the window whatever the length of
+        the stream. Elapsed time is kept in double; the head clock only keeps the time within the
+        model's rotation period, like the event simulation (see streamWindow). A drive cache, if
+        simulated, starts empty and lasts the whole stream. With --coalesce each window goes
+        through the merge stage before the scheduler sees it.
+    parameters:
+        Policy         I/P  class          Scheduling policy (see schedPolicy.cpp)
+        &source        I/P  Source         genSource or traceSource
+        cfg            I/P  streamConfig   Streaming settings
+        streamWindows  O/P  streamResults  Statistics of the whole stream
+*/
+template <class Policy, class Source>
+streamResults streamWindows(Source &source, const streamConfig &cfg)
+{
+    std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+
+    headState head = startHead();
+    pooledBatch window(threadReqPool());
+    latencyHist latency;
+    latencySink = &latency;
+    driveCache cache;
+    if (cacheSettings.segments > 0)
+    {
+        cache.clear();
+        activeCache = &cache;
+    }
+    reqMerger merger;
+    pooledBatch merged(threadReqPool());
+    if (mergeSettings.maxBlocks > 0)
+        activeMerger = &merger;
+
+    long long done = 0, seeks = 0, hits = 0, absorbed = 0;
+    double elapsed = 0;
+    while (cfg.requests == 0 || done < cfg.requests)
+    {
+        int want = cfg.requests == 0 ? cfg.window : (int)min((long long)cfg.window, cfg.requests - done);
+        int got = source.fill(*window, want);
+        if (got == 0)
+            break;
+
+        reqSpan requests = window->span();
+        if (activeMerger)
+        {
+            merger.merge(requests, *merged);
+            requests = merged->span();
+            absorbed += merger.absorbed();
+        }
+        streamWindow<Policy>(head, requests, elapsed, seeks, hits);
+        done += got;
+    }
+    latencySink = nullptr;
+    latencyOrigin = 0;
+    activeCache = nullptr;
+    activeMerger = nullptr;
+
+    streamResults res;
+    res.requests = done;
+    res.simTime = elapsed;
+    res.avgSeek = done > 0 ? (double)seeks / done : 0;
+    res.cacheHits = hits;
+    res.merged = absorbed;
+    res.latency = latency.summary();
+    res.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return res;
+}
+
+/*
+    streamResults streamRun<Policy>(cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run one streaming experiment with one scheduling policy, on the trace if one is
+        given and on generated requests otherwise.
+    parameters:
+        Policy     I/P  class          Scheduling policy (see schedPolicy.cpp)
+        cfg        I/P  streamConfig   Streaming settings
+        streamRun  O/P  streamResults  Statistics of the whole stream
+*/
+template <class Policy>
+streamResults streamRun(const streamConfig &cfg)
+{
+    if (cfg.trace != nullptr)
+    {
+        traceSource source(cfg);
+        return streamWindows<Policy>(source, cfg);
+    }
+    genSource source(cfg);
+    return streamWindows<Policy>(source, cfg);
+}
@@ -0,0 +1,486 @@
+/*
+file: sweepShard.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    shardOwns - Whether a chunk of a sweep test is run by this shard.
+    writeShard - Write a shard's partial results to a file.
+    runShard - Run this shard's part of the sweep and write its partial results.
+    readShard - Read a shard file written by writeShard.
+    sameSweep - Whether two shard files come from the same sweep.
+    mergeShards - Merge shard files into the results of the whole sweep and report them.
+    runShardProcs - Run the sweep as local shard processes and merge their results (not on Windows).
+*/
+
+/* A sweep is split into shards by work chunk: chunk c of test p (the p-th request count) belongs to
+   shard (p * chunks + c) % N, so every shard runs an even share of every test. Experiment seeds
+   depend only on the base seed and the experiment's place in the sweep, so a shard runs exactly the
+   experiments a single run would, and its file keeps each chunk's sums and replicate stats apart.
+   Merging lays the chunks of all the shards side by side and reduces them in index order like
+   executeAlg does, so the merged results are bit-identical to a single run's; latency histograms
+   are integer counts and are added up. Shards may run anywhere with the same build, drive and seed.
+
+   A shard file is written in native byte order:
+       magic "HDDSHRD3"
+       u32 seed, i32 shard index, i32 shard count, i32 experiments per test,
+       u8 sampling mode, u8 control, i32 nstep, i32 tracks, i32 rpm, i32 zones, i32 cache segments,
+       u16 length and bytes of the drive config path (empty for the built-in drive),
+       u16 algorithms, then per algorithm:
+           u16 length and bytes of its name, u16 tests, then per test:
+               i32 requests, i32 chunks, then per chunk:
+                   u8 done, and if done: f32 access time sum, f32 total time sum, i32 request sum,
+                   i64 replicates, f64 control mean, f64 time mean, f64 control and time squared
+                   deviations, f64 co-deviation, i64 cache hits, f32 seek, rotation and transfer
+                   time sums, i64 track switches, i64 missed rotations
+               the test's latency histogram (latencyHist::save) */
+#define SHARD_MAGIC "HDDSHRD3"
+
+/* Settings of the sweep a shard file belongs to; shards merge only if all but the index match */
+struct shardHeader
+{
+    unsigned seed;              // Base randomization seed
+    int shardIndex;             // Which shard the file holds
+    int shardCount;             // Number of shards the sweep was split into
+    int limit;                  // Experiments per test (sweepLimit)
+    char sampling;              // sampling.mode
+    bool control;               // sampling.control
+    int nstep;                  // nstepSize
+    int tracks;                 // drive.tracks
+    int rpm;                    // drive.rpm
+    int zones;                  // Number of drive zones
+    int cacheSegments;          // cacheSettings.segments
+    string drivePath;           // Drive config, empty for the built-in drive
+    vector<string> algs;        // Algorithm names, in the order their partials follow
+};
+
+/* Fixed-size values are written as their bytes; strings as a u16 length and the bytes */
+template <class T>
+void putShard(FILE *out, T value)
+{
+    fwrite(&value, sizeof value, 1, out);
+}
+
+template <class T>
+bool getShard(FILE *in, T &value)
+{
+    return fread(&value, sizeof value, 1, in) == 1;
+}
+
+void putShardText(FILE *out, const string &text)
+{
+    putShard(out, (uint16_t)text.size());
+    fwrite(text.data(), 1, text.size(), out);
+}
+
+bool getShardText(FILE *in, string &text)
+{
+    uint16_t len;
+    if (!getShard(in, len))
+        return false;
+    text.resize(len);
+    return fread(&text[0], 1, len, in) == len;
+}
+
+/*
+    bool shardOwns(cfg, point, chunk, chunks)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Whether a chunk of a sweep test is run by shard cfg.shardIndex of cfg.shardCount.
+    parameters:
+        cfg        I/P  simConfig  Command line options
+        point      I/P  int        Index of the test in the sweep (0 for 50 requests)
+        chunk      I/P  int        Index of the chunk in the test
+        chunks     I/P  int        Chunks per test
+        shardOwns  O/P  bool       True if this shard runs the chunk
+*/
+bool shardOwns(const simConfig &cfg, int point, int chunk, int chunks)
+{
+    return (point * chunks + chunk) % cfg.shardCount == cfg.shardIndex;
+}
+
+/*
+    bool writeShard(out, cfg, parts)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Write a shard's partial results to a file in the layout described above.
+    parameters:
+        out         I/P  FILE*                          File to write to
+        cfg         I/P  simConfig                      Command line options the shard ran with
+        parts       I/P  vector<vector<pointPartial>>   Partials per algorithm, in cfg.algs order
+        writeShard  O/P  bool                           False if the file could not be written
+*/
+bool writeShard(FILE *out, const simConfig &cfg, const vector<vector<pointPartial>> &parts)
+{
+    fwrite(SHARD_MAGIC, 1, 8, out);
+    putShard(out, (uint32_t)cfg.seed);
+    putShard(out, (int32_t)cfg.shardIndex);
+    putShard(out, (int32_t)cfg.shardCount);
+    putShard(out, (int32_t)sweepLimit(cfg));
+    putShard(out, (uint8_t)sampling.mode);
+    putShard(out, (uint8_t)sampling.control);
+    putShard(out, (int32_t)nstepSize);
+    putShard(out, (int32_t)drive.tracks);
+    putShard(out, (int32_t)drive.rpm);
+    putShard(out, (int32_t)drive.zones.size());
+    putShard(out, (int32_t)cacheSettings.segments);
+    putShardText(out, cfg.drivePath ? cfg.drivePath : "");
+
+    putShard(out, (uint16_t)parts.size());
+    for (size_t k = 0; k < parts.size(); k++)
+    {
+        putShardText(out, schedRegistry()[cfg.algs[k]].name);
+        putShard(out, (uint16_t)parts[k].size());
+        for (const pointPartial &point : parts[k])
+        {
+            putShard(out, (int32_t)point.io);
+            putShard(out, (int32_t)point.chunks.size());
+            for (const chunkPartial &part : point.chunks)
+            {
+                putShard(out, (uint8_t)part.done);
+                if (!part.done)
+                    continue;
+                putShard(out, part.sums.totalAvgAccessTime);
+                putShard(out, part.sums.avgReqTime);
+                putShard(out, (int32_t)part.sums.totalReq);
+                putShard(out, (int64_t)part.stats.n);
+                putShard(out, part.stats.meanX);
+                putShard(out, part.stats.meanY);
+                putShard(out, part.stats.m2X);
+                putShard(out, part.stats.m2Y);
+                putShard(out, part.stats.cXY);
+                putShard(out, (int64_t)part.cacheHits);
+                putShard(out, part.sums.seekTime);
+                putShard(out, part.sums.rotationTime);
+                putShard(out, part.sums.transferTime);
+                putShard(out, (int64_t)part.trackSwitches);
+                putShard(out, (int64_t)part.missedRotations);
+            }
+            point.latency.save(out);
+        }
+    }
+
+    if (fflush(out) != 0 || ferror(out))
+    {
+        cerr << "cannot write shard results\n";
+        return false;
+    }
+    return true;
+}
+
+/*
+    bool runShard(cfg, pool, out)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run this shard's part of the sweep for every selected algorithm and write the
+        partial results to a file.
+    parameters:
+        cfg       I/P  simConfig   Command line options; cfg.shardCount is set
+        pool      I/P  threadPool  Threads used to run the experiments
+        out       I/P  FILE*       File to write the partial results to
+        runShard  O/P  bool        False if the file could not be written
+*/
+bool runShard(const simConfig &cfg, threadPool &pool, FILE *out)
+{
+    vector<vector<pointPartial>> parts;
+    for (int a : cfg.algs)
+        parts.push_back(schedRegistry()[a].shard(cfg, pool));
+    return writeShard(out, cfg, parts);
+}
+
+/*
+    bool readShard(path, &head, &parts)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Read a shard file written by writeShard. Prints a message naming the file if it
+        cannot be read or is not a shard file.
+    parameters:
+        path       I/P  char*                          Shard file
+        &head      O/P  shardHeader                    Settings of the sweep the shard belongs to
+        &parts     O/P  vector<vector<pointPartial>>   Partials per algorithm, in head.algs order
+        readShard  O/P  bool                           False on a missing, damaged or foreign file
+*/
+bool readShard(const char *path, shardHeader &head, vector<vector<pointPartial>> &parts)
+{
+    FILE *in = fopen(path, "rb");
+    if (in == nullptr)
+    {
+        cerr << "cannot read shard: " << path << "\n";
+        return false;
+    }
+
+    char magic[8];
+    uint8_t mode, control;
+    uint16_t algs;
+    bool ok = fread(magic, 1, 8, in) == 8 && memcmp(magic, SHARD_MAGIC, 8) == 0;
+    ok = ok && getShard(in, head.seed) && getShard(in, head.shardIndex) && getShard(in, head.shardCount) &&
+         getShard(in, head.limit) && getShard(in, mode) && getShard(in, control) && getShard(in, head.nstep) &&
+         getShard(in, head.tracks) && getShard(in, head.rpm) && getShard(in, head.zones) &&
+         getShard(in, head.cacheSegments) && getShardText(in, head.drivePath) && getShard(in, algs);
+    head.sampling = (char)mode;
+    head.control = control != 0;
+    const int chunks = (head.limit + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    head.algs.clear();
+    parts.clear();
+    for (int a = 0; ok && a < algs; a++)
+    {
+        string name;
+        uint16_t points;
+        ok = getShardText(in, name) && getShard(in, points);
+        head.algs.push_back(name);
+        parts.emplace_back(ok ? points : 0);
+        for (pointPartial &point : parts.back())
+        {
+            int32_t io, count;
+            ok = ok && getShard(in, io) && getShard(in, count) && count == chunks;
+            if (!ok)
+                break;
+            point.io = io;
+            point.chunks.assign(chunks, chunkPartial());
+            for (chunkPartial &part : point.chunks)
+            {
+                uint8_t done = 0;
+                int32_t totalReq;
+                int64_t n, hits, switches, missed;
+                ok = ok && getShard(in, done);
+                part.done = done != 0;
+                if (!ok || !part.done)
+                    continue;
+                ok = getShard(in, part.sums.totalAvgAccessTime) && getShard(in, part.sums.avgReqTime) &&
+                     getShard(in, totalReq) && getShard(in, n) && getShard(in, part.stats.meanX) &&
+                     getShard(in, part.stats.meanY) && getShard(in, part.stats.m2X) &&
+                     getShard(in, part.stats.m2Y) && getShard(in, part.stats.cXY) && getShard(in, hits) &&
+                     getShard(in, part.sums.seekTime) && getShard(in, part.sums.rotationTime) &&
+                     getShard(in, part.sums.transferTime) && getShard(in, switches) && getShard(in, missed);
+                part.sums.totalReq = totalReq;
+                part.stats.n = n;
+                part.cacheHits = hits;
+                part.trackSwitches = switches;
+                part.missedRotations = missed;
+            }
+            ok = ok && point.latency.load(in);
+        }
+    }
+    fclose(in);
+
+    if (!ok)
+        cerr << "not a readable shard file: " << path << "\n";
+    return ok;
+}
+
+/*
+    bool sameSweep(a, b)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Whether two shard files come from the same sweep: everything but the shard index
+        matches.
+    parameters:
+        a          I/P  shardHeader  Settings of one shard
+        b          I/P  shardHeader  Settings of the other
+        sameSweep  O/P  bool         True if they can be merged
+*/
+bool sameSweep(const shardHeader &a, const shardHeader &b)
+{
+    return a.seed == b.seed && a.shardCount == b.shardCount && a.limit == b.limit && a.sampling == b.sampling &&
+           a.control == b.control && a.nstep == b.nstep && a.tracks == b.tracks && a.rpm == b.rpm &&
+           a.zones == b.zones && a.cacheSegments == b.cacheSegments && a.drivePath == b.drivePath && a.algs == b.algs;
+}
+
+/*
+    bool mergeShards(&cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Merge the shard files in cfg.mergePaths into the results of the whole sweep and
+        report them like a single run would (reportSweep). Every chunk must come from exactly one
+        shard. The sweep's seed, algorithms, sampling, N-SCAN step, drive cache and drive are taken
+        from the files; the drive config is loaded from the path recorded in them unless --drive was given.
+    parameters:
+        &cfg         I/P  simConfig  Command line options; the sweep's settings are filled in
+        mergeShards  O/P  bool       False if a shard is unreadable, foreign, repeated or missing
+*/
+bool mergeShards(simConfig &cfg)
+{
+    shardHeader head = shardHeader();
+    vector<vector<pointPartial>> merged;
+    for (size_t f = 0; f < cfg.mergePaths.size(); f++)
+    {
+        shardHeader h;
+        vector<vector<pointPartial>> parts;
+        if (!readShard(cfg.mergePaths[f], h, parts))
+            return false;
+        if (f == 0)
+        {
+            head = h;
+            merged = std::move(parts);
+            continue;
+        }
+        if (!sameSweep(head, h) || parts.size() != merged.size())
+        {
+            cerr << cfg.mergePaths[f] << " is not from the same sweep as " << cfg.mergePaths[0] << "\n";
+            return false;
+        }
+
+        for (size_t a = 0; a < merged.size(); a++)
+        {
+            for (size_t p = 0; p < merged[a].size() && p < parts[a].size(); p++)
+            {
+                pointPartial &into = merged[a][p];
+                for (size_t c = 0; c < into.chunks.size(); c++)
+                {
+                    if (!parts[a][p].chunks[c].done)
+                        continue;
+                    if (into.chunks[c].done)
+                    {
+                        cerr << cfg.mergePaths[f] << " repeats shard " << h.shardIndex << "\n";
+                        return false;
+                    }
+                    into.chunks[c] = parts[a][p].chunks[c];
+                }
+                into.latency.merge(parts[a][p].latency);
+            }
+        }
+    }
+
+    // every chunk must have been run by some shard
+    for (const vector<pointPartial> &points : merged)
+    {
+        for (size_t p = 0; p < points.size(); p++)
+        {
+            const int chunks = (int)points[p].chunks.size();
+            for (int c = 0; c < chunks; c++)
+            {
+                if (points[p].chunks[c].done)
+                    continue;
+                cerr << "shard " << (p * chunks + c) % head.shardCount << " of " << head.shardCount
+                     << " is missing\n";
+                return false;
+            }
+        }
+    }
+
+    // take the sweep's settings from the shards
+    cfg.seed = head.seed;
+    sampling.mode = head.sampling;
+    sampling.control = head.control;
+    nstepSize = head.nstep;
+    cacheSettings.segments = head.cacheSegments;
+    cfg.algs.clear();
+    for (const string &name : head.algs)
+    {
+        int found = findPolicy(name.c_str());
+        if (found < 0)
+        {
+            cerr << "shards were run with an unknown algorithm: " << name << "\n";
+            return false;
+        }
+        cfg.algs.push_back(found);
+    }
+    if (cfg.drivePath == nullptr && !head.drivePath.empty())
+    {
+        static string drivePath;
+        drivePath = head.drivePath;
+        cfg.drivePath = drivePath.c_str();
+        if (!loadDriveModel(cfg.drivePath, drive))
+            return false;
+    }
+    if (drive.tracks != head.tracks || drive.rpm != head.rpm || (int)drive.zones.size() != head.zones)
+    {
+        cerr << "the drive does not match the one the shards were run on\n";
+        return false;
+    }
+
+    vector<vector<results>> algResults(schedRegistry().size());
+    for (size_t k = 0; k < merged.size(); k++)
+    {
+        for (const pointPartial &point : merged[k])
+            algResults[cfg.algs[k]].push_back(reducePoint(point, (int)point.chunks.size()));
+    }
+    resultSink sink(cfg.format, stdout);
+    reportSweep(cfg, algResults, sink);
+    return true;
+}
+
+#if !defined(_WIN32)
+/*
+    bool runShardProcs(&cfg)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Run the sweep as cfg.procs local shard processes, each with an even share of
+        cfg.threads, writing to temporary files in $TMPDIR (or /tmp) that are merged (mergeShards)
+        and removed once all of them have finished. Only the first shard draws a progress bar. Must
+        be called before any thread is started, since the shards are forked. Windows has no fork,
+        so it is left out there and --procs is refused (see parseArgs).
+    parameters:
+        &cfg           I/P  simConfig  Command line options; cfg.procs is above 1
+        runShardProcs  O/P  bool       False if a shard failed or the merge did
+*/
+bool runShardProcs(simConfig &cfg)
+{
+    const char *dir = getenv("TMPDIR");
+    if (dir == nullptr || *dir == 0)
+        dir = "/tmp";
+
+    simConfig shardCfg = cfg;
+    shardCfg.shardCount = cfg.procs;
+    shardCfg.threads = max(1, cfg.threads / cfg.procs);
+
+    vector<string> paths;
+    vector<pid_t> children;
+    bool ok = true;
+    for (int k = 0; k < cfg.procs; k++)
+    {
+        string path = string(dir) + "/hddSimShardXXXXXX";
+        int fd = mkstemp(&path[0]);
+        if (fd < 0)
+        {
+            cerr << "cannot create a shard file in " << dir << "\n";
+            ok = false;
+            break;
+        }
+        paths.push_back(path);
+
+        // nothing buffered may be written twice by parent and child
+        fflush(stdout);
+        cerr.flush();
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            shardCfg.shardIndex = k;
+            showProgress = showProgress && k == 0;
+            FILE *out = fdopen(fd, "wb");
+            threadPool pool(shardCfg.threads);
+            bool written = out != nullptr && runShard(shardCfg, pool, out) && fclose(out) == 0;
+            _exit(written ? 0 : 1);
+        }
+        close(fd);
+        if (pid < 0)
+        {
+            cerr << "cannot start shard process " << k << "\n";
+            ok = false;
+            break;
+        }
+        children.push_back(pid);
+    }
+
+    for (pid_t pid : children)
+    {
+        int status;
+        ok = waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0 && ok;
+    }
+
+    if (ok)
+    {
+        cfg.mergePaths.clear();
+        for (const string &path : paths)
+            cfg.mergePaths.push_back(path.c_str());
+        ok = mergeShards(cfg);
+    }
+    else
+        cerr << "a shard process failed\n";
+    for (const string &path : paths)
+        unlink(path.c_str());
+    return ok;
+}
+#endif
@@ -0,0 +1,177 @@
+/*
+file: threadPool.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    threadPool - Constructor method that starts the worker threads.
+    ~threadPool - Destructor method that stops and joins the worker threads.
+    run - Execute a number of chunks across the pool and wait for them to finish.
+    workerLoop - Body of each worker thread; claims chunks until none remain.
+    defaultThreads - Number of threads to use when none are requested.
+*/
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+/* True while the current thread is executing a chunk of some pool's run, including the calling
+   thread's share; work started from inside a chunk must not post to a pool again */
+thread_local bool inPoolChunk = false;
+
+class threadPool
+{
+public:
+    threadPool(int n);
+    ~threadPool();
+    void run(int chunks, const std::function<void(int chunk, int worker)> &fn);
+    int size() const { return workerCount; }
+    static bool inChunk() { return inPoolChunk; }
+
+private:
+    void workerLoop(int worker);
+
+    int workerCount;
+    std::vector<std::thread> workers;
+    std::mutex m;
+    std::condition_variable wake, done;
+    const std::function<void(int, int)> *job = nullptr;
+    int jobChunks = 0;
+    std::atomic<int> nextChunk{0};
+    int active = 0;
+    unsigned generation = 0;
+    bool stopping = false;
+};
+
+/*
+    threadPool(n)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that starts the worker threads. The calling thread always takes part
+        in run(), so a pool of size n only spawns n - 1 extra threads and a pool of size 1 spawns none.
+    parameters:
+        n  I/P  int  Total number of threads that execute chunks
+*/
+threadPool::threadPool(int n)
+{
+    workerCount = n < 1 ? 1 : n;
+    for (int w = 1; w < workerCount; w++)
+        workers.emplace_back(&threadPool::workerLoop, this, w);
+}
+
+/*
+    ~threadPool()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Destructor method that stops and joins the worker threads.
+*/
+threadPool::~threadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &t : workers)
+        t.join();
+}
+
+/*
+    void run(chunks, fn)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Execute fn once for every chunk index in [0, chunks) and return once all have finished.
+        Threads claim the next unclaimed chunk from a shared counter, so faster threads simply take more
+        chunks. Which thread runs a chunk is not fixed, so fn must only write to per-chunk storage.
+        fn runs with inChunk() true, so it does not post nested work to a pool.
+    parameters:
+        chunks  I/P  int       Number of chunks to execute
+        fn      I/P  function  Work for one chunk; receives the chunk index and the worker index
+*/
+void threadPool::run(int chunks, const std::function<void(int chunk, int worker)> &fn)
+{
+    const bool outer = inPoolChunk;
+    inPoolChunk = true;
+    if (workerCount == 1 || chunks <= 1)
+    {
+        // serial path: no synchronisation at all
+        for (int c = 0; c < chunks; c++)
+            fn(c, 0);
+        inPoolChunk = outer;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m);
+        job = &fn;
+        jobChunks = chunks;
+        nextChunk.store(0);
+        active = workerCount - 1;
+        generation++;
+    }
+    wake.notify_all();
+
+    // the calling thread works as worker 0
+    for (int c = nextChunk.fetch_add(1); c < chunks; c = nextChunk.fetch_add(1))
+        fn(c, 0);
+    inPoolChunk = outer;
+
+    std::unique_lock<std::mutex> lock(m);
+    done.wait(lock, [this] { return active == 0; });
+    job = nullptr;
+}
+
+/*
+    void workerLoop(worker)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Body of each worker thread; sleeps until a job is posted, claims chunks until none remain.
+    parameters:
+        worker  I/P  int  Index of this worker (1 to size - 1)
+*/
+void threadPool::workerLoop(int worker)
+{
+    unsigned seen = 0;
+    inPoolChunk = true;
+    while (true)
+    {
+        const std::function<void(int, int)> *fn;
+        int chunks;
+        {
+            std::unique_lock<std::mutex> lock(m);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            fn = job;
+            chunks = jobChunks;
+        }
+
+        for (int c = nextChunk.fetch_add(1); c < chunks; c = nextChunk.fetch_add(1))
+            (*fn)(c, worker);
+
+        {
+            std::lock_guard<std::mutex> lock(m);
+            active--;
+        }
+        done.notify_one();
+    }
+}
+
+/*
+    int defaultThreads()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Number of threads to use when none are requested (one per hardware thread).
+    parameters:
+        defaultThreads  O/P  int  Thread count, at least 1
+*/
+int defaultThreads()
+{
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : (int)n;
+}
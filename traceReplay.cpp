@@ -0,0 +1,440 @@
+/*
+file: traceReplay.cpp
+author: Gherkin
+modification history:
+    Gherkin
+    October 16th, 2026
+procedures:
+    traceFile - Constructor method that maps a trace file into memory read-only.
+    ~traceFile - Destructor method that unmaps the trace file.
+    traceReader - Constructor method that starts reading a mapped trace from its first line.
+    traceReader::next - Parse the next I/O record out of the trace.
+    traceReader::parseBlkparse - Parse one line of blkparse text output.
+    traceReader::parseMsr - Parse one line of an MSR-Cambridge style CSV trace.
+    detectTraceFormat - Guess the format of a trace from its first record line.
+    mapLba - Map a byte offset on the traced device onto a simulated track and sector.
+    parseBytes - Read a byte count with an optional K/M/G/T suffix.
+*/
+
+#include <cstdint>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Pages behind a reader are released every this many bytes, so replaying a trace of any size keeps
+   a bounded amount of it resident */
+#define TRACE_RELEASE_BYTES (64u << 20)
+
+/* One I/O taken from a trace, before it is mapped onto the simulated drive. The simulator serves
+   every request as a one-block read, so the traced size and direction are not kept. */
+struct traceRecord
+{
+    double time;                // Issue time in ms since the first record
+    uint64_t offset;            // Byte offset on the traced device
+};
+
+/* A trace file mapped read-only into memory. Readers parse straight out of the mapping, so nothing
+   is copied and several readers can share one file. */
+class traceFile
+{
+public:
+    traceFile(const char *path);
+    ~traceFile();
+    traceFile(const traceFile &) = delete;
+    traceFile &operator=(const traceFile &) = delete;
+    bool ok() const { return valid; }
+    const char *begin() const { return data; }
+    const char *end() const { return data + size; }
+    void release(const char *from, const char *to) const;
+
+private:
+    const char *data;
+    size_t size;
+    bool valid;                 // Opened and mapped (or empty)
+#if defined(_WIN32)
+    HANDLE file, mapping;
+#else
+    int fd;
+#endif
+};
+
+/* Streaming parser over a mapped trace. format is 'b' for blkparse text output or 'm' for
+   MSR-Cambridge style CSV (Timestamp,Hostname,DiskNumber,Type,Offset,Size,ResponseTime). */
+class traceReader
+{
+public:
+    traceReader(const traceFile &file, char format, size_t limit = SIZE_MAX);
+    bool next(traceRecord &r);
+
+private:
+    bool parseBlkparse(const char *p, const char *end, traceRecord &r);
+    bool parseMsr(const char *p, const char *end, traceRecord &r);
+
+    const traceFile &file;
+    char format;
+    const char *pos;            // Start of the next line
+    const char *stop;           // No line starting at or after this is read
+    const char *released;       // Pages before this have been handed back
+    bool started;               // The first record's time has been seen
+    double firstTime;           // Time of the first record in the trace's own unit
+};
+
+/*
+    traceFile(path)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that maps a trace file into memory read-only and tells the
+        kernel it will be read sequentially. ok() is false if the file cannot be opened or mapped.
+    parameters:
+        path  I/P  char*  Path of the trace file
+*/
+traceFile::traceFile(const char *path) : data(nullptr), size(0), valid(false)
+{
+#if defined(_WIN32)
+    mapping = nullptr;
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER len;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &len))
+        return;
+    size = (size_t)len.QuadPart;
+    valid = size == 0;
+    if (size == 0)
+        return;
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping != nullptr)
+        data = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    valid = data != nullptr;
+#else
+    fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+        return;
+    size = (size_t)st.st_size;
+    valid = size == 0;
+    if (size == 0)
+        return;
+    void *m = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m == MAP_FAILED)
+        return;
+    madvise(m, size, MADV_SEQUENTIAL);
+    data = (const char *)m;
+    valid = true;
+#endif
+}
+
+/*
+    ~traceFile()
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Destructor method that unmaps and closes the trace file.
+*/
+traceFile::~traceFile()
+{
+#if defined(_WIN32)
+    if (data != nullptr)
+        UnmapViewOfFile(data);
+    if (mapping != nullptr)
+        CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+#else
+    if (data != nullptr)
+        munmap((void *)data, size);
+    if (fd >= 0)
+        close(fd);
+#endif
+}
+
+/*
+    void release(from, to)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Hand the whole pages between two points of the mapping back to the kernel. They
+        stay in the page cache, so another reader still behind this point faults them back in
+        without touching the disk.
+    parameters:
+        from  I/P  char*  Start of the consumed range
+        to    I/P  char*  End of the consumed range
+*/
+void traceFile::release(const char *from, const char *to) const
+{
+#if !defined(_WIN32)
+    const uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t a = ((uintptr_t)from + page - 1) & ~(page - 1);
+    uintptr_t b = (uintptr_t)to & ~(page - 1);
+    if (b > a)
+        madvise((void *)a, b - a, MADV_DONTNEED);
+#else
+    (void)from;
+    (void)to;
+#endif
+}
+
+/*
+    traceReader(file, format, limit)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Constructor method that starts reading a mapped trace from its first line.
+    parameters:
+        file    I/P  traceFile  Mapped trace; must outlive the reader
+        format  I/P  char       'b' blkparse, 'm' MSR CSV
+        limit   I/P  size_t     Only lines starting in the first limit bytes are read
+*/
+traceReader::traceReader(const traceFile &f, char fmt, size_t limit)
+    : file(f), format(fmt), pos(f.begin()),
+      stop(f.begin() + min(limit, (size_t)(f.end() - f.begin()))), released(f.begin()),
+      started(false), firstTime(0)
+{
+}
+
+/* Skip spaces and tabs */
+inline const char *skipBlanks(const char *p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+        p++;
+    return p;
+}
+
+/* Read an unsigned decimal integer; returns null if there are no digits */
+inline const char *readUnsigned(const char *p, const char *end, uint64_t &v)
+{
+    const char *start = p;
+    v = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+        v = v * 10 + (uint64_t)(*p++ - '0');
+    return p == start ? nullptr : p;
+}
+
+/* Read a non-negative decimal with an optional fraction ("12.000345"); returns null on no digits */
+inline const char *readDecimal(const char *p, const char *end, double &v)
+{
+    uint64_t whole;
+    p = readUnsigned(p, end, whole);
+    if (p == nullptr)
+        return nullptr;
+    v = (double)whole;
+    if (p < end && *p == '.')
+    {
+        double scale = 0.1;
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, scale *= 0.1)
+            v += (*p - '0') * scale;
+    }
+    return p;
+}
+
+/* Skip one whitespace separated token */
+inline const char *skipToken(const char *p, const char *end)
+{
+    p = skipBlanks(p, end);
+    while (p < end && *p != ' ' && *p != '\t')
+        p++;
+    return p;
+}
+
+/*
+    bool parseBlkparse(p, end, &r)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Parse one line of blkparse default text output:
+            8,0  3  1  0.000000000  697  Q  W  223490 + 8 [kjournald]
+        Only queue (Q) events are taken, so every I/O is counted once as it reaches the block
+        layer. Sectors are 512 bytes; the time is in seconds. The direction and sector count must
+        be present but are not kept. Other lines are skipped.
+    parameters:
+        p              I/P  char*        Start of the line
+        end            I/P  char*        End of the line
+        &r             O/P  traceRecord  Parsed record (time in seconds until rebased)
+        parseBlkparse  O/P  bool         True if the line held a queued I/O
+*/
+bool traceReader::parseBlkparse(const char *p, const char *end, traceRecord &r)
+{
+    p = skipToken(p, end); // device
+    p = skipToken(p, end); // cpu
+    p = skipToken(p, end); // sequence
+    double t;
+    if ((p = readDecimal(skipBlanks(p, end), end, t)) == nullptr)
+        return false;
+    p = skipToken(p, end); // pid
+    p = skipBlanks(p, end);
+    if (p + 1 >= end || p[0] != 'Q' || (p[1] != ' ' && p[1] != '\t'))
+        return false;
+    p = skipToken(p + 1, end); // direction
+    uint64_t sector, count;
+    if ((p = readUnsigned(skipBlanks(p, end), end, sector)) == nullptr)
+        return false;
+    p = skipBlanks(p, end);
+    if (p >= end || *p != '+' || readUnsigned(skipBlanks(p + 1, end), end, count) == nullptr)
+        return false;
+
+    r.time = t;
+    r.offset = sector * 512;
+    return true;
+}
+
+/*
+    bool parseMsr(p, end, &r)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Parse one line of an MSR-Cambridge style CSV trace:
+            128166372003061629,hm,0,Read,3386339328,4096,13839
+        The timestamp is in 100 ns ticks and the offset is in bytes; the type and size must be
+        present but are not kept. Header or malformed lines are skipped.
+    parameters:
+        p         I/P  char*        Start of the line
+        end       I/P  char*        End of the line
+        &r        O/P  traceRecord  Parsed record (time in ticks until rebased)
+        parseMsr  O/P  bool         True if the line held an I/O
+*/
+bool traceReader::parseMsr(const char *p, const char *end, traceRecord &r)
+{
+    uint64_t ticks, offset, bytes;
+    if ((p = readUnsigned(p, end, ticks)) == nullptr)
+        return false;
+    for (int f = 0; f < 3; f++) // hostname, disk number, type
+    {
+        p = (const char *)memchr(p, ',', end - p);
+        if (p == nullptr)
+            return false;
+        p++;
+    }
+    p = (const char *)memchr(p, ',', end - p);
+    if (p == nullptr || (p = readUnsigned(p + 1, end, offset)) == nullptr || p >= end || *p != ',')
+        return false;
+    if (readUnsigned(p + 1, end, bytes) == nullptr)
+        return false;
+
+    r.time = (double)ticks;
+    r.offset = offset;
+    return true;
+}
+
+/*
+    bool next(&r)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Parse the next I/O record out of the trace, skipping lines that hold none. Times
+        are rebased so the first record is at 0 ms. Every TRACE_RELEASE_BYTES the pages already read
+        are released.
+    parameters:
+        &r    O/P  traceRecord  The next record
+        next  O/P  bool         False at the end of the trace
+*/
+bool traceReader::next(traceRecord &r)
+{
+    const char *end = file.end();
+    while (pos < stop)
+    {
+        const char *eol = (const char *)memchr(pos, '\n', end - pos);
+        const char *lineEnd = eol == nullptr ? end : eol;
+        const char *line = pos;
+        pos = eol == nullptr ? end : eol + 1;
+        if (lineEnd > line && lineEnd[-1] == '\r')
+            lineEnd--;
+
+        if ((size_t)(pos - released) >= TRACE_RELEASE_BYTES)
+        {
+            file.release(released, line);
+            released = line;
+        }
+
+        bool ok = format == 'm' ? parseMsr(line, lineEnd, r) : parseBlkparse(skipBlanks(line, lineEnd), lineEnd, r);
+        if (!ok)
+            continue;
+
+        if (!started)
+        {
+            started = true;
+            firstTime = r.time;
+        }
+        // blkparse times are seconds, MSR times are 100 ns ticks
+        r.time = format == 'm' ? (r.time - firstTime) / 10000 : (r.time - firstTime) * 1000;
+        return true;
+    }
+    return false;
+}
+
+/*
+    char detectTraceFormat(file)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Guess the format of a trace by parsing its opening lines both ways and keeping the
+        format that finds more records. Header and summary lines are skipped by both parsers.
+    parameters:
+        file               I/P  traceFile  Mapped trace
+        detectTraceFormat  O/P  char       'm' or 'b'
+*/
+char detectTraceFormat(const traceFile &file)
+{
+    int found[2] = {0, 0};
+    const char formats[2] = {'b', 'm'};
+    for (int f = 0; f < 2; f++)
+    {
+        traceReader reader(file, formats[f], 64 << 10);
+        traceRecord r;
+        while (reader.next(r))
+            found[f]++;
+    }
+    return found[1] > found[0] ? 'm' : 'b';
+}
+
+/*
+    void mapLba(offset, span, &track, &sector)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Map a byte offset on the traced device onto a simulated track and sector. The
+        simulated drive holds drive.blocks blocks of BLOCK_SIZE KB, numbered zone by zone and
+        track by track. With a span (the traced device's size) the device is scaled linearly onto
+        the drive, which keeps seek distances in proportion. Without one, block numbers wrap around
+        the drive, which keeps sequential runs sequential.
+    parameters:
+        offset  I/P  uint64_t  Byte offset on the traced device
+        span    I/P  uint64_t  Size of the traced device in bytes, or 0 to wrap
+        &track  O/P  int       Simulated track
+        &sector O/P  int       Simulated sector
+*/
+inline void mapLba(uint64_t offset, uint64_t span, int &track, int &sector)
+{
+    const uint64_t blocks = drive.blocks;
+    uint64_t block;
+    if (span > 0)
+        block = (uint64_t)((unsigned __int128)(offset % span) * blocks / span);
+    else
+        block = (offset / (BLOCK_SIZE * 1024)) % blocks;
+    placeBlock(block, track, sector);
+}
+
+/*
+    uint64_t parseBytes(text)
+    author: Gherkin
+    date: Oct 16, 2026
+    description: Read a byte count with an optional K, M, G or T suffix (powers of 1024).
+    parameters:
+        text        I/P  char*     Text such as "500G"
+        parseBytes  O/P  uint64_t  Number of bytes
+*/
+uint64_t parseBytes(const char *text)
+{
+    char *suffix;
+    double v = strtod(text, &suffix);
+    switch (toupper(*suffix))
+    {
+    case 'T':
+        v *= 1024;
+        // fall through
+    case 'G':
+        v *= 1024;
+        // fall through
+    case 'M':
+        v *= 1024;
+        // fall through
+    case 'K':
+        v *= 1024;
+    }
+    return (uint64_t)v;
+}